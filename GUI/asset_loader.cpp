@@ -0,0 +1,92 @@
+#include "asset_loader.hpp"
+#include <algorithm>
+using namespace thd;
+
+AssetLoader& AssetLoader::get() {
+	static AssetLoader loader;
+	return loader;
+}
+
+void AssetLoader::request_image(const std::string& path, ImageCallback on_ready, const void* owner) {
+	ImageRequest& request = m_image_requests[path];
+	request.waiting.push_back({ owner, std::move(on_ready) });
+	if (request.in_flight) return;
+
+	request.in_flight = true;
+	m_pending++;
+	m_pool.submit([this, path] {
+		auto image = std::make_shared<sf::Image>();
+		const bool loaded = image->loadFromFile(path);
+
+		complete([this, path, image, loaded] {
+			m_pending--;
+
+			const auto it = m_image_requests.find(path);
+			if (it == m_image_requests.end()) return;
+
+			const std::vector<Waiting<ImageCallback>> waiting = std::move(it->second.waiting);
+			m_image_requests.erase(it);
+
+			for (const auto& entry : waiting) {
+				entry.callback(loaded ? image.get() : nullptr);
+			}
+		});
+	});
+}
+
+void AssetLoader::request_text(const std::string& path, TextCallback on_ready, const void* owner) {
+	const std::size_t id = m_next_text_request++;
+	m_text_requests.emplace(id, Waiting<TextCallback>{ owner, std::move(on_ready) });
+
+	m_pending++;
+	m_pool.submit([this, path, id] {
+		auto source = std::make_shared<TextSource>();
+		const bool loaded = source->open_file(path);
+
+		complete([this, source, loaded, id] {
+			m_pending--;
+
+			const auto it = m_text_requests.find(id);
+			if (it == m_text_requests.end()) return;
+
+			const TextCallback callback = std::move(it->second.callback);
+			m_text_requests.erase(it);
+			callback(loaded ? source.get() : nullptr);
+		});
+	});
+}
+
+void AssetLoader::cancel(const void* owner) {
+	for (auto& request : m_image_requests) {
+		auto& waiting = request.second.waiting;
+		waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+			[owner](const Waiting<ImageCallback>& entry) { return entry.owner == owner; }), waiting.end());
+	}
+
+	for (auto it = m_text_requests.begin(); it != m_text_requests.end();) {
+		if (it->second.owner == owner) {
+			it = m_text_requests.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+bool AssetLoader::poll() {
+	std::vector<std::function<void()>> completed;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		completed.swap(m_completed);
+	}
+
+	for (const auto& completion : completed) {
+		completion();
+	}
+	return !completed.empty();
+}
+
+void AssetLoader::complete(std::function<void()> completion) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_completed.push_back(std::move(completion));
+}
@@ -0,0 +1,73 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include "thread_pool.hpp"
+#include "text_source.hpp"
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace thd
+{
+
+// Reads and decodes assets on worker threads, the results are handed back on the main thread
+// because textures and everything touching the GL context must be created there
+class AssetLoader {
+public:
+	// Receives nullptr when the asset could not be loaded
+	typedef std::function<void(const sf::Image* image)> ImageCallback;
+	typedef std::function<void(TextSource* source)> TextCallback;
+
+	static AssetLoader& get();
+
+	// Decodes the image file off the main thread, concurrent requests for one path share the decode
+	// the owner tags the callback so it can be cancelled
+	void request_image(const std::string& path, ImageCallback on_ready, const void* owner = nullptr);
+	// Opens the text file off the main thread
+	void request_text(const std::string& path, TextCallback on_ready, const void* owner = nullptr);
+	// Drops the owner's callbacks without waiting, their loads still finish but report to nobody
+	void cancel(const void* owner);
+
+	// Runs the callbacks of finished loads, call from the main thread every frame
+	// returns true if any asset arrived
+	bool poll();
+	// Requests still in flight, the host loop should keep polling while there are any
+	bool has_pending() const { return m_pending > 0; }
+
+	ThreadPool& get_pool() { return m_pool; }
+private:
+	AssetLoader() = default;
+
+	template <typename Callback>
+	struct Waiting {
+		const void* owner;
+		Callback callback;
+	};
+
+	// Waiting callbacks of one image file, which is decoded at most once at a time
+	struct ImageRequest {
+		std::vector<Waiting<ImageCallback>> waiting;
+		bool in_flight = false;
+	};
+
+	void complete(std::function<void()> completion);
+
+	std::mutex m_mutex;
+	std::vector<std::function<void()>> m_completed;
+
+	// Main thread only, the workers never see the callbacks so cancelling needs no synchronization
+	std::unordered_map<std::string, ImageRequest> m_image_requests;
+	std::unordered_map<std::size_t, Waiting<TextCallback>> m_text_requests;
+	std::size_t m_next_text_request = 0;
+	std::size_t m_pending = 0;
+
+	// Declared last so the workers are joined before the state they report into is destroyed
+	ThreadPool m_pool;
+};
+
+} // namespace thd
+#endif // ASSET_LOADER_HPP
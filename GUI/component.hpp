@@ -2,8 +2,11 @@
 #define COMPONENT_HPP
 
 #include <SFML/Graphics.hpp>
+#include "render_batch.hpp"
+#include "size_value.hpp"
 #include <string>
 #include <memory>
+#include <limits>
 
 namespace thd
 { 
@@ -20,6 +23,16 @@ enum AnchorPoint {
 	BottomRight
 };
 
+// How a component is sized along the main axis of a flex container
+struct FlexItem {
+	float grow = 0.0f;
+	float shrink = 1.0f;
+	// Size before growing or shrinking, a negative basis uses the component's current size
+	float basis = -1.0f;
+	float min_size = 0.0f;
+	float max_size = std::numeric_limits<float>::max();
+};
+
 class Component {
 public:
 	Component(const std::string& identifier) : m_identifier(identifier) {}
@@ -27,24 +40,119 @@ public:
 
 	virtual void update(float dt, const sf::RenderWindow& window) = 0;
 	virtual void render(sf::RenderTarget& target) = 0;
+	// Draws into a shared batch, components that cannot be batched flush it and draw directly
+	virtual void render_batched(RenderBatch& batch) {
+		if (!batch.is_visible(get_bounds())) return;
+
+		batch.flush();
+		render(batch.get_target());
+	}
 	virtual void handle_event(const sf::Event& event, sf::RenderWindow& window) {}
+	// Focused components keep receiving keyboard and mouse press events from the EventRouter
+	virtual bool has_focus() const { return false; }
 
 	virtual void set_position(const sf::Vector2f& position) = 0;
 	virtual void set_size(const sf::Vector2f& size) = 0;
 	virtual sf::Vector2f get_position() const = 0;
 	virtual sf::Vector2f get_size() const = 0;
+	// Area the component draws into
+	virtual sf::FloatRect get_bounds() const { return sf::FloatRect(get_position(), get_size()); }
 
-	virtual std::shared_ptr<sf::Text> get_label() const { return nullptr; }
+	virtual const sf::Text* get_label() const { return nullptr; }
 
 	// Sets the label's string
 	virtual void set_label_text(const std::string& text) {}
-	std::string get_identifier() const { return m_identifier; }
+	const std::string& get_identifier() const { return m_identifier; }
 
-	void set_anchor_point(AnchorPoint anchor_point) { m_anchor_point = anchor_point; }
+	void set_anchor_point(AnchorPoint anchor_point) {
+		m_anchor_point = anchor_point;
+		if (m_parent) {
+			m_parent->invalidate_layout();
+		}
+	}
 	AnchorPoint get_anchor_point() const { return m_anchor_point; }
+
+	void set_flex(const FlexItem& flex) {
+		m_flex = flex;
+		if (m_parent) {
+			m_parent->invalidate_layout();
+		}
+	}
+	const FlexItem& get_flex() const { return m_flex; }
+
+	// Width and height the size was resolved from, the layout re-resolves relative ones
+	void set_size_expression(const SizeValue& width, const SizeValue& height) {
+		m_width_expression = width;
+		m_height_expression = height;
+	}
+	const SizeValue& get_width_expression() const { return m_width_expression; }
+	const SizeValue& get_height_expression() const { return m_height_expression; }
+
+	// Components whose views map onto the window follow its size
+	virtual void set_screen_size(const sf::Vector2f& screen_size) {}
+
+	void set_parent(Component* parent) { m_parent = parent; }
+	Component* get_parent() const { return m_parent; }
+
+	// Marks the layout of this component as stale, it is recomputed on the next flush_layout()
+	void invalidate_layout() {
+		m_layout_dirty = true;
+		if (m_parent) {
+			m_parent->mark_descendant_dirty();
+		}
+	}
+	bool needs_layout() const { return m_layout_dirty || m_has_dirty_descendant; }
+
+	// Recomputes every stale layout in this subtree, returns true if anything was arranged
+	virtual bool flush_layout() { return false; }
+	// Receives the geometry computed by a layout pass, which already covers the subtree,
+	// so overrides must not invalidate the layout again
+	virtual void apply_layout(const sf::Vector2f& position, const sf::Vector2f& size) {
+		if (get_position() != position) set_position(position);
+		if (get_size() != size) set_size(size);
+	}
+
+	// Reports a visual change of this component, cached ancestors re-render
+	// and the area is redrawn on the next frame
+	void invalidate_render() { invalidate_render(get_bounds()); }
+	void invalidate_render(const sf::FloatRect& area) {
+		Component* node = this;
+		for (;; node = node->m_parent) {
+			node->m_render_dirty = true;
+			if (!node->m_parent) break;
+		}
+		node->on_damage(area);
+	}
+	bool needs_redraw() const { return m_render_dirty; }
+	void clear_redraw() { m_render_dirty = false; }
+	// Components that change over time without events (e.g. a blinking cursor) keep the host loop awake
+	virtual bool is_animating() const { return false; }
+
+	// Components drawing through their own sf::View cannot be rendered into a container cache
+	virtual bool has_own_view() const { return false; }
+
+	// Damage area covering the whole render target
+	inline static const sf::FloatRect FULL_DAMAGE = sf::FloatRect(-1e9f, -1e9f, 2e9f, 2e9f);
 protected:
+	// Receives every area damaged in the tree when this component is its root
+	virtual void on_damage(const sf::FloatRect& area) {}
+
+	// Flags this component and its ancestors as having a stale layout somewhere below them
+	void mark_descendant_dirty() {
+		for (Component* node = this; node && !node->m_has_dirty_descendant; node = node->m_parent) {
+			node->m_has_dirty_descendant = true;
+		}
+	}
+
 	AnchorPoint m_anchor_point = AnchorPoint::TopLeft;
+	FlexItem m_flex;
+	SizeValue m_width_expression;
+	SizeValue m_height_expression;
 	std::string m_identifier = "";
+	Component* m_parent = nullptr;
+	bool m_layout_dirty = false;
+	bool m_has_dirty_descendant = false;
+	bool m_render_dirty = true;
 };
 
 } // namespace thd
@@ -0,0 +1,55 @@
+#include "component_index.hpp"
+#include "container.hpp"
+#include <algorithm>
+using namespace thd;
+
+ComponentIndex::IdentifierId ComponentIndex::intern(const std::string& identifier) {
+	const auto result = m_ids.emplace(identifier, static_cast<IdentifierId>(m_components.size()));
+	if (result.second) {
+		m_components.emplace_back();
+	}
+	return result.first->second;
+}
+
+ComponentIndex::IdentifierId ComponentIndex::find_id(const std::string& identifier) const {
+	const auto it = m_ids.find(identifier);
+	return it != m_ids.end() ? it->second : INVALID_ID;
+}
+
+void ComponentIndex::insert(const std::shared_ptr<Component>& component) {
+	m_components[intern(component->get_identifier())].push_back(component);
+
+	if (const auto container = std::dynamic_pointer_cast<Container>(component)) {
+		container->set_index(this);
+	}
+}
+
+void ComponentIndex::remove(const std::shared_ptr<Component>& component) {
+	const IdentifierId id = find_id(component->get_identifier());
+	if (id != INVALID_ID) {
+		auto& entries = m_components[id];
+		entries.erase(std::remove_if(entries.begin(), entries.end(),
+			[&component](const std::weak_ptr<Component>& entry) {
+				return entry.expired() || entry.lock() == component;
+			}), entries.end());
+	}
+
+	if (const auto container = std::dynamic_pointer_cast<Container>(component)) {
+		container->set_index(nullptr);
+	}
+}
+
+std::shared_ptr<Component> ComponentIndex::find(const std::string& identifier) const {
+	return find(find_id(identifier));
+}
+
+std::shared_ptr<Component> ComponentIndex::find(IdentifierId id) const {
+	if (id >= m_components.size()) return nullptr;
+
+	for (const auto& entry : m_components[id]) {
+		if (auto component = entry.lock()) {
+			return component;
+		}
+	}
+	return nullptr;
+}
@@ -0,0 +1,35 @@
+#ifndef COMPONENT_INDEX_HPP
+#define COMPONENT_INDEX_HPP
+
+#include "component.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace thd
+{
+
+// Identifier lookup across a whole component tree, containers attached to the index
+// keep it current from add_component/delete_component
+class ComponentIndex {
+public:
+	typedef unsigned IdentifierId;
+	static const IdentifierId INVALID_ID = ~0u;
+
+	// Returns the interned id of the identifier, adding it if it is new
+	IdentifierId intern(const std::string& identifier);
+	IdentifierId find_id(const std::string& identifier) const;
+
+	// Registers the component and, for containers, its whole subtree
+	void insert(const std::shared_ptr<Component>& component);
+	void remove(const std::shared_ptr<Component>& component);
+
+	// Returns the first registered component with the identifier
+	std::shared_ptr<Component> find(const std::string& identifier) const;
+	std::shared_ptr<Component> find(IdentifierId id) const;
+private:
+	std::unordered_map<std::string, IdentifierId> m_ids;
+	std::vector<std::vector<std::weak_ptr<Component>>> m_components;
+};
+
+} // namespace thd
+#endif // COMPONENT_INDEX_HPP
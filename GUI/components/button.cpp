@@ -1,96 +1,120 @@
 #include "button.hpp"
+#include "../profiler.hpp"
 using namespace thd;
 
 Button::Button(const std::string& identifier, const sf::Vector2f& position, const sf::Vector2f& size,
 	const sf::Color& color, const sf::Color& hover_color, const sf::Color& click_color,
-	const std::string& label_text, const sf::Font& font, unsigned font_size, std::function<void()> on_click): Component(identifier), m_color(color), m_hover_color(hover_color), m_click_color(click_color), m_on_click(on_click), m_position(position), m_size(size), m_text(std::make_shared<sf::Text>(label_text, font, font_size))
+	const std::string& label_text, const sf::Font& font, unsigned font_size, std::function<void()> on_click): Component(identifier), m_color(color), m_hover_color(hover_color), m_click_color(click_color), m_on_click(on_click), m_position(position), m_size(size), m_text(label_text, font, font_size)
 {
-	m_shape = std::make_shared<sf::RectangleShape>();
-	m_shape->setSize(size);
-	m_shape->setPosition(position);
-	m_shape->setFillColor(color);
+	m_shape.setSize(size);
+	m_shape.setPosition(position);
+	m_shape.setFillColor(color);
 
-	m_text->setCharacterSize(font_size);
-	m_text->setFillColor(sf::Color::White);
+	m_text.setCharacterSize(font_size);
+	m_text.setFillColor(sf::Color::White);
 
-	const sf::FloatRect label_bounds = m_text->getLocalBounds();
-	m_text->setOrigin(label_bounds.width / 2.f, label_bounds.top + label_bounds.height / 2.f);
-	m_text->setPosition(position.x + size.x / 2.f, position.y + size.y / 2.f);
+	const sf::FloatRect label_bounds = m_text.getLocalBounds();
+	m_text.setOrigin(label_bounds.width / 2.f, label_bounds.top + label_bounds.height / 2.f);
+	m_text.setPosition(position.x + size.x / 2.f, position.y + size.y / 2.f);
 }
 
-void Button::update(float dt, const sf::RenderWindow& window)
-{
-	sf::Vector2f mouse_position = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+void Button::update(float dt, const sf::RenderWindow& window) {}
 
-	if (m_shape->getGlobalBounds().contains(mouse_position))
+void Button::handle_event(const sf::Event& event, sf::RenderWindow& window)
+{
+	switch (event.type)
 	{
-		m_is_hovered = true;
-
-		if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
+		case sf::Event::MouseMoved:
+		{
+			const sf::Vector2f mouse_position = window.mapPixelToCoords(sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
+			m_is_hovered = m_shape.getGlobalBounds().contains(mouse_position);
+			if (!m_is_hovered)
+			{
+				m_is_clicked = false;
+			}
+			break;
+		}
+		case sf::Event::MouseButtonPressed:
 		{
-			if (!m_is_clicked)
+			const sf::Vector2f mouse_position = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+			if (event.mouseButton.button == sf::Mouse::Button::Left && m_shape.getGlobalBounds().contains(mouse_position))
 			{
+				m_is_hovered = true;
 				m_is_clicked = true;
 			}
+			break;
 		}
-		else if (m_is_clicked)
+		case sf::Event::MouseButtonReleased:
 		{
-			m_is_clicked = false;
-			if (m_on_click)
+			const sf::Vector2f mouse_position = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+			if (event.mouseButton.button == sf::Mouse::Button::Left && m_is_clicked)
 			{
-				m_on_click();
+				m_is_clicked = false;
+				if (m_shape.getGlobalBounds().contains(mouse_position) && m_on_click)
+				{
+					m_on_click();
+				}
 			}
+			break;
 		}
-	}
-	else
-	{
-		m_is_hovered = false;
-		m_is_clicked = false;
+		case sf::Event::MouseLeft:
+		{
+			m_is_hovered = false;
+			m_is_clicked = false;
+			break;
+		}
+		default:
+			return;
 	}
 
-	if (m_is_clicked)
-	{
-		m_shape->setFillColor(m_click_color);
-	}
-	else if (m_is_hovered)
-	{
-		m_shape->setFillColor(m_hover_color);
-	}
-	else
+	update_color();
+}
+
+void Button::update_color()
+{
+	const sf::Color& color = m_is_clicked ? m_click_color : (m_is_hovered ? m_hover_color : m_color);
+
+	if (m_shape.getFillColor() != color)
 	{
-		m_shape->setFillColor(m_color);
+		m_shape.setFillColor(color);
+		invalidate_render();
 	}
 }
 
 void Button::render(sf::RenderTarget& target) {
-	if (m_shape) {
-		target.draw(*m_shape);
-	}
-	if (m_text) {
-		target.draw(*m_text);
-	}
+	target.draw(m_shape);
+	target.draw(m_text);
+}
+
+void Button::render_batched(RenderBatch& batch) {
+	batch.draw_rectangle(m_shape);
+	batch.draw_text(m_text);
 }
 
 void Button::set_position(const sf::Vector2f& position)
 {
+	invalidate_render();
 	m_position = position;
-	m_shape->setPosition(position);
+	m_shape.setPosition(position);
 
-	m_text->setPosition(
+	m_text.setPosition(
 		position.x + m_size.x / 2.f,
-		position.y + (m_size.y - m_text->getCharacterSize()) / 2.f + m_text->getCharacterSize() / 2.f
+		position.y + (m_size.y - m_text.getCharacterSize()) / 2.f + m_text.getCharacterSize() / 2.f
 	);
+	invalidate_render();
 }
 
 void Button::set_size(const sf::Vector2f& size)
 {
+	invalidate_render();
 	m_size = size;
-	m_shape->setSize(size);
+	m_shape.setSize(size);
 
-	m_text->setPosition(
+	m_text.setPosition(
 		m_position.x + size.x / 2.f,
-		m_position.y + (size.y - m_text->getCharacterSize()) / 2.f + m_text->getCharacterSize() / 2.f
+		m_position.y + (size.y - m_text.getCharacterSize()) / 2.f + m_text.getCharacterSize() / 2.f
 	);
+	invalidate_render();
 }
 
 sf::Vector2f Button::get_position() const
@@ -105,15 +129,17 @@ sf::Vector2f Button::get_size() const
 
 void Button::set_label(const std::string& label_text)
 {
-	m_text->setString(label_text);
+	m_text.setString(label_text);
+	Profiler::get().count_text_layout();
 
-	m_text->setOrigin(
-		m_text->getLocalBounds().width / 2.f,
-		m_text->getCharacterSize() / 2.f
+	m_text.setOrigin(
+		m_text.getLocalBounds().width / 2.f,
+		m_text.getCharacterSize() / 2.f
 	);
 
-	m_text->setPosition(
+	m_text.setPosition(
 		m_position.x + m_size.x / 2.f,
 		m_position.y + m_size.y / 2.f
 	);
+	invalidate_render();
 }
\ No newline at end of file
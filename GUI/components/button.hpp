@@ -17,6 +17,8 @@ public:
 
 	void update(float dt, const sf::RenderWindow& window) override;
 	void render(sf::RenderTarget& target) override;
+	void handle_event(const sf::Event& event, sf::RenderWindow& window) override;
+	void render_batched(RenderBatch& batch) override;
 
 	void set_position(const sf::Vector2f& position) override;
 	void set_size(const sf::Vector2f& size) override;
@@ -26,6 +28,8 @@ public:
 	// Sets the label's string
 	void set_label(const std::string& label_text);
 private:
+	void update_color();
+
 	sf::Color m_color;
 	sf::Color m_hover_color;
 	sf::Color m_click_color;
@@ -34,8 +38,8 @@ private:
 	bool m_is_clicked = false;
 	sf::Vector2f m_position;
 	sf::Vector2f m_size;
-	std::shared_ptr<sf::Text> m_text;
-	std::shared_ptr<sf::RectangleShape> m_shape;
+	sf::Text m_text;
+	sf::RectangleShape m_shape;
 };
 
 } // namespace thd
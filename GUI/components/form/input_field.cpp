@@ -1,4 +1,5 @@
 #include "input_field.hpp"
+#include "../../profiler.hpp"
 #include <iostream>
 using namespace thd;
 
@@ -7,14 +8,13 @@ InputField::InputField(const std::string& identifier, const sf::Vector2f& positi
 	const sf::Color& text_color, const sf::Color& cursor_color, const std::string& placeholder_text,
 	const std::string& text, const float screen_size_x, const float screen_size_y)
 	: Component(identifier), m_color(color), m_text_color(text_color), m_cursor_color(cursor_color),
-	m_font(font), m_font_size(font_size), m_cursor_position(0), m_cursor_visible(true),
-	m_text_string(text), m_size(size), m_screen_size_x(screen_size_x), m_screen_size_y(screen_size_y), m_text(std::make_shared<sf::Text>(text, font, font_size)), m_placeholder_text(std::make_shared<sf::Text>(placeholder_text, font, font_size)){
+	m_font(&font), m_font_size(font_size), m_cursor_position(0), m_cursor_visible(true),
+	m_text_string(text), m_size(size), m_screen_size_x(screen_size_x), m_screen_size_y(screen_size_y), m_text(text, font, font_size), m_placeholder_text(placeholder_text, font, font_size), m_shape(size){
 
-	m_shape = std::make_shared<sf::RectangleShape>(size);
-	m_shape->setFillColor(color);
+	m_shape.setFillColor(color);
 
-	m_text->setFillColor(text_color);
-	m_placeholder_text->setFillColor(sf::Color(text_color.r, text_color.g, text_color.b, text_color.a / 2));
+	m_text.setFillColor(text_color);
+	m_placeholder_text.setFillColor(sf::Color(text_color.r, text_color.g, text_color.b, text_color.a / 2));
 
 	set_position(position);
 
@@ -26,20 +26,16 @@ InputField::InputField(const std::string& identifier, const sf::Vector2f& positi
 }
 
 void InputField::render(sf::RenderTarget& target) {
-	if (m_shape) {
-		target.draw(*m_shape);
-	}
+	target.draw(m_shape);
 
 	sf::View original_view = target.getView();
 	target.setView(m_view);
 
 	if (m_text_string.empty()) {
-		target.draw(*m_placeholder_text);
+		target.draw(m_placeholder_text);
 	}
 	else {
-		if (m_text) {
-			target.draw(*m_text);
-		}
+		target.draw(m_text);
 	}
 
 	if (m_is_focused && m_cursor_visible) {
@@ -49,18 +45,18 @@ void InputField::render(sf::RenderTarget& target) {
 	target.setView(original_view);
 }
 
-std::shared_ptr<sf::Text> InputField::get_label() const
+const sf::Text* InputField::get_label() const
 {
-	return m_text;
+	return &m_text;
 }
 
 void InputField::update(float dt, const sf::RenderWindow& window) {
-	if (m_cursor_timer.getElapsedTime().asSeconds() >= 0.5f) {
+	// The cursor is only drawn, and therefore only blinks, while focused
+	if (m_is_focused && m_cursor_timer.getElapsedTime().asSeconds() >= 0.5f) {
 		m_cursor_visible = !m_cursor_visible;
 		m_cursor_timer.restart();
+		invalidate_render();
 	}
-
-	update_displayed_text();
 }
 
 void InputField::handle_event(const sf::Event& event, sf::RenderWindow& window) {
@@ -89,10 +85,16 @@ void InputField::handle_mouse_press(const sf::Event& event, sf::RenderWindow& wi
 	sf::Vector2f world_pos = window.mapPixelToCoords(pixel_pos);
 
 	bool was_focused = m_is_focused;
-	m_is_focused = m_shape->getGlobalBounds().contains(world_pos);
+	m_is_focused = m_shape.getGlobalBounds().contains(world_pos);
+
+	if (m_is_focused != was_focused) {
+		m_cursor_visible = true;
+		m_cursor_timer.restart();
+		invalidate_render();
+	}
 
 	if (m_is_focused) {
-		const float click_x = world_pos.x - m_shape->getPosition().x;
+		const float click_x = world_pos.x - m_shape.getPosition().x;
 
 		m_cursor_position = calculate_cursor_position_from_x(click_x, window);
 		update_cursor_position();
@@ -168,11 +170,12 @@ unsigned InputField::calculate_cursor_position_from_x(const float& click_x, cons
 	sf::Vector2f world_pos = window.mapPixelToCoords(sf::Vector2i(static_cast<int>(click_x), 0), m_view);
 
 	sf::Text temp_text;
-	temp_text.setFont(m_font);
+	temp_text.setFont(*m_font);
 	temp_text.setCharacterSize(m_font_size);
 
 	for (size_t i = 0; i <= m_text_string.length(); ++i) {
 		temp_text.setString(m_text_string.substr(0, i));
+		Profiler::get().count_text_layout();
 		if (temp_text.getGlobalBounds().width >= world_pos.x) {
 			return static_cast<unsigned>(i - 1);
 		}
@@ -202,10 +205,11 @@ unsigned InputField::find_next_word() {
 }
 
 void InputField::update_displayed_text() {
-	m_text->setString(m_text_string);
+	m_text.setString(m_text_string);
+	Profiler::get().count_text_layout();
 	update_cursor_position();
 
-	float text_width = m_text->getGlobalBounds().width;
+	float text_width = m_text.getGlobalBounds().width;
 	float cursor_x = m_cursor.getPosition().x;
 
 	// Right edge
@@ -219,9 +223,9 @@ void InputField::update_displayed_text() {
 }
 
 void InputField::update_cursor_position() {
-	const float cursor_offset_x = m_text->findCharacterPos(m_cursor_position).x;
+	const float cursor_offset_x = m_text.findCharacterPos(m_cursor_position).x;
 
-	m_cursor.setPosition(cursor_offset_x, m_text->getPosition().y + 2.5f);
+	m_cursor.setPosition(cursor_offset_x, m_text.getPosition().y + 2.5f);
 
 	// Right edge
 	if (m_cursor.getPosition().x > m_view.getCenter().x + m_size.x / 2.0f - 10.0f) {
@@ -231,10 +235,22 @@ void InputField::update_cursor_position() {
 	else if (m_cursor.getPosition().x < m_view.getCenter().x - m_size.x / 2.0f + 10.0f) {
 		m_view.setCenter(m_cursor.getPosition().x + m_size.x / 2.0f - 10.0f, m_view.getCenter().y);
 	}
+
+	invalidate_render();
+}
+
+void InputField::set_screen_size(const sf::Vector2f& screen_size) {
+	if (screen_size.x == m_screen_size_x && screen_size.y == m_screen_size_y) return;
+
+	m_screen_size_x = screen_size.x;
+	m_screen_size_y = screen_size.y;
+
+	update_view();
+	invalidate_render();
 }
 
 void InputField::update_view() {
-	const sf::FloatRect bounds = m_shape->getGlobalBounds();
+	const sf::FloatRect bounds = m_shape.getGlobalBounds();
 
 	m_view.setCenter(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
 
@@ -248,29 +264,29 @@ void InputField::update_view() {
 }
 
 void InputField::set_position(const sf::Vector2f& position) {
-	m_shape->setPosition(position);
+	m_shape.setPosition(position);
 
-	float vertical_center = position.y + m_shape->getSize().y / 2 - m_placeholder_text->getLocalBounds().height + 5.0f;
+	float vertical_center = position.y + m_shape.getSize().y / 2 - m_placeholder_text.getLocalBounds().height + 5.0f;
 
-	m_text->setPosition(position.x, vertical_center);
-	m_placeholder_text->setPosition(m_text->getPosition());
+	m_text.setPosition(position.x, vertical_center);
+	m_placeholder_text.setPosition(m_text.getPosition());
 
 	update_view();
 	update_cursor_position();
 }
 
 void InputField::set_size(const sf::Vector2f& size) {
-	m_shape->setSize(size);
+	m_shape.setSize(size);
 	update_view();
 	update_cursor_position();
 }
 
 sf::Vector2f InputField::get_position() const {
-	return m_shape->getPosition();
+	return m_shape.getPosition();
 }
 
 sf::Vector2f InputField::get_size() const {
-	return m_shape->getSize();
+	return m_shape.getSize();
 }
 
 void InputField::set_text(const std::string& text) {
@@ -283,16 +299,19 @@ std::string InputField::get_text() const {
 }
 
 void InputField::set_placeholder_text(const std::string& placeholder_text) {
-	m_placeholder_text->setString(placeholder_text);
+	m_placeholder_text.setString(placeholder_text);
+	Profiler::get().count_text_layout();
+	invalidate_render();
 }
 
 std::string InputField::get_placeholder_text() const {
-	return m_placeholder_text->getString();
+	return m_placeholder_text.getString();
 }
 
 void InputField::set_color(const sf::Color& color) {
 	m_color = color;
-	m_shape->setFillColor(color);
+	m_shape.setFillColor(color);
+	invalidate_render();
 }
 
 sf::Color InputField::get_color() const {
@@ -301,7 +320,8 @@ sf::Color InputField::get_color() const {
 
 void InputField::set_text_color(const sf::Color& text_color) {
 	m_text_color = text_color;
-	m_text->setFillColor(text_color);
+	m_text.setFillColor(text_color);
+	invalidate_render();
 }
 
 sf::Color InputField::get_text_color() const {
@@ -311,6 +331,7 @@ sf::Color InputField::get_text_color() const {
 void InputField::set_cursor_color(const sf::Color& cursor_color) {
 	m_cursor_color = cursor_color;
 	m_cursor.setFillColor(cursor_color);
+	invalidate_render();
 }
 
 sf::Color InputField::get_cursor_color() const {
@@ -318,19 +339,21 @@ sf::Color InputField::get_cursor_color() const {
 }
 
 void InputField::set_font(const sf::Font& font) {
-	m_font = font;
-	m_text->setFont(font);
-	m_placeholder_text->setFont(font);
+	m_font = &font;
+	m_text.setFont(font);
+	m_placeholder_text.setFont(font);
+	invalidate_render();
 }
 
 const sf::Font& InputField::get_font() const {
-	return m_font;
+	return *m_font;
 }
 
 void InputField::set_font_size(unsigned font_size) {
 	m_font_size = font_size;
-	m_text->setCharacterSize(font_size);
-	m_placeholder_text->setCharacterSize(font_size);
+	m_text.setCharacterSize(font_size);
+	m_placeholder_text.setCharacterSize(font_size);
+	invalidate_render();
 }
 
 unsigned InputField::get_font_size() const {
@@ -348,6 +371,7 @@ unsigned InputField::get_cursor_position() const {
 
 void InputField::set_is_focused(bool is_focused) {
 	m_is_focused = is_focused;
+	invalidate_render();
 }
 
 bool InputField::get_is_focused() const {
@@ -38,7 +38,11 @@ public:
 	unsigned get_cursor_position() const;
 	void set_is_focused(bool is_focused);
 	bool get_is_focused() const;
-	std::shared_ptr<sf::Text> get_label() const;
+	bool has_focus() const override { return m_is_focused; }
+	bool has_own_view() const override { return true; }
+	bool is_animating() const override { return m_is_focused; }
+	void set_screen_size(const sf::Vector2f& screen_size) override;
+	const sf::Text* get_label() const override;
 
 	void handle_event(const sf::Event& event, sf::RenderWindow& window) override;
 	void handle_mouse_press(const sf::Event& event, sf::RenderWindow& window);
@@ -52,9 +56,9 @@ private:
 	void update_cursor_position();
 	void update_view();
 
-	std::shared_ptr<sf::Text> m_text;
-	std::shared_ptr<sf::Text> m_placeholder_text;
-	std::shared_ptr<sf::RectangleShape> m_shape;
+	sf::Text m_text;
+	sf::Text m_placeholder_text;
+	sf::RectangleShape m_shape;
 	sf::RectangleShape m_cursor;
 	sf::Vector2f m_size;
 	sf::View m_view;
@@ -63,7 +67,7 @@ private:
 	sf::Color m_outline_color;
 	sf::Color m_text_color;
 	sf::Color m_cursor_color;
-	sf::Font m_font;
+	const sf::Font* m_font;
 	unsigned m_font_size;
 
 	std::string m_text_string;
@@ -72,8 +76,8 @@ private:
 	bool m_cursor_visible = true;
 	sf::Clock m_cursor_timer; 
 
-	const float m_screen_size_x = 0.f;
-	const float m_screen_size_y = 0.f;
+	float m_screen_size_x = 0.f;
+	float m_screen_size_y = 0.f;
 };
 
 } // namespace thd
@@ -2,34 +2,59 @@
 using namespace thd;
 
 Image::Image(const std::string& identifier, const std::string& path, int width, int height)
-	: Component(identifier), m_width(width), m_height(height)
+	: Image(identifier, width, height)
 {
-	m_texture = std::make_shared<sf::Texture>();
-	if (!m_texture->loadFromFile(path)) {
+	if (!assign_texture(path)) {
 		throw std::runtime_error("Failed to load image: " + path);
 	}
+}
 
-	m_sprite = std::make_shared<sf::Sprite>();
-	m_sprite->setTexture(*m_texture);
+Image::Image(const std::string& identifier, int width, int height)
+	: Component(identifier), m_width(width), m_height(height)
+{
+	m_placeholder.setFillColor(sf::Color(128, 128, 128, 64));
 	set_size(sf::Vector2f(static_cast<float>(width), static_cast<float>(height)));
 }
 
 void Image::render(sf::RenderTarget& target) {
-	target.draw(*m_sprite);
+	if (m_texture) {
+		target.draw(m_sprite);
+	}
+	else {
+		target.draw(m_placeholder);
+	}
+}
+
+void Image::render_batched(RenderBatch& batch) {
+	if (m_texture) {
+		batch.draw_sprite(m_sprite);
+	}
+	else {
+		batch.draw_rectangle(m_placeholder);
+	}
 }
 
 void Image::set_position(const sf::Vector2f& position) {
-	m_sprite->setPosition(position);
+	invalidate_render();
+	m_sprite.setPosition(position);
+	m_placeholder.setPosition(position);
 	m_position = position;
+	invalidate_render();
 }
 
 void Image::set_size(const sf::Vector2f& size) {
+	invalidate_render();
 	m_width = static_cast<int>(size.x);
 	m_height = static_cast<int>(size.y);
-	m_sprite->setScale(
-		size.x / m_texture->getSize().x,
-		size.y / m_texture->getSize().y
-	);
+	m_placeholder.setSize(size);
+	if (m_texture) {
+		const sf::IntRect& rect = m_sprite.getTextureRect();
+		m_sprite.setScale(
+			size.x / rect.width,
+			size.y / rect.height
+		);
+	}
+	invalidate_render();
 }
 
 sf::Vector2f Image::get_position() const {
@@ -41,9 +66,39 @@ sf::Vector2f Image::get_size() const {
 }
 
 void Image::set_path(const std::string& path) {
-	if (!m_texture->loadFromFile(path)) {
+	if (!assign_texture(path)) {
 		throw std::runtime_error("Failed to load image: " + path);
 	}
-	m_sprite->setTexture(*m_texture);
+}
+
+bool Image::set_image(const std::string& path, const sf::Image& image) {
+	AtlasRegion region;
+	// The decoded image is packed or uploaded directly, the file is never read twice
+	if (!TextureAtlas::get().add(path, image, region)) {
+		region.texture = TextureCache::get().insert(path, image);
+		if (!region.texture) return false;
+		region.rect = sf::IntRect(0, 0, static_cast<int>(image.getSize().x), static_cast<int>(image.getSize().y));
+	}
+
+	show(region);
+	return true;
+}
+
+bool Image::assign_texture(const std::string& path) {
+	AtlasRegion region;
+	if (!TextureAtlas::get().find(path, region)) {
+		region.texture = TextureCache::get().load(path);
+		if (!region.texture) return false;
+		region.rect = sf::IntRect(0, 0, static_cast<int>(region.texture->getSize().x), static_cast<int>(region.texture->getSize().y));
+	}
+
+	show(region);
+	return true;
+}
+
+void Image::show(const AtlasRegion& region) {
+	m_texture = region.texture;
+	m_sprite.setTexture(*m_texture);
+	m_sprite.setTextureRect(region.rect);
 	set_size(sf::Vector2f(static_cast<float>(m_width), static_cast<float>(m_height)));
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define IMAGE_HPP
 
 #include "../component.hpp"
+#include "../texture_atlas.hpp"
 
 namespace thd
 {
@@ -9,8 +10,11 @@ namespace thd
 class Image : public Component {
 public:
 	Image(const std::string& identifier, const std::string& path, int width, int height);
+	// Shows a placeholder until set_image() provides the picture
+	Image(const std::string& identifier, int width, int height);
 
 	void render(sf::RenderTarget& target) override;
+	void render_batched(RenderBatch& batch) override;
 	void update(float dt, const sf::RenderWindow& window) override {}
 
 	void set_position(const sf::Vector2f& position) override;
@@ -19,9 +23,17 @@ public:
 	sf::Vector2f get_size() const override;
 
 	void set_path(const std::string& path);
+	// Displays an image decoded off the main thread, packing it into the atlas when it is small enough
+	bool set_image(const std::string& path, const sf::Image& image);
+	bool is_loaded() const { return m_texture != nullptr; }
 private:
-	std::shared_ptr<sf::Texture> m_texture;
-	std::shared_ptr<sf::Sprite> m_sprite;
+	// Points the sprite at the packed atlas region of the path, or at a texture of its own
+	bool assign_texture(const std::string& path);
+	void show(const AtlasRegion& region);
+
+	TextureHandle m_texture;
+	sf::Sprite m_sprite;
+	sf::RectangleShape m_placeholder;
 	int m_width;
 	int m_height;
 	sf::Vector2f m_position;
@@ -0,0 +1,88 @@
+#include "profiler_overlay.hpp"
+#include <cstdio>
+using namespace thd;
+
+ProfilerOverlay::ProfilerOverlay(const std::string& identifier, const sf::Font& font, unsigned font_size,
+	const sf::Vector2f& position)
+	: Component(identifier), m_text("", font, font_size)
+{
+	m_background.setFillColor(sf::Color(0, 0, 0, 180));
+	m_background.setPosition(position);
+	m_text.setFillColor(sf::Color::White);
+	m_text.setPosition(position + sf::Vector2f(6.f, 4.f));
+	refresh();
+}
+
+void ProfilerOverlay::update(float dt, const sf::RenderWindow& window) {
+	m_elapsed += dt;
+	if (m_elapsed < m_refresh_interval) return;
+
+	m_elapsed = 0.0f;
+	refresh();
+}
+
+void ProfilerOverlay::refresh() {
+	const Profiler& profiler = Profiler::get();
+	if (!profiler.is_enabled()) {
+		m_text.setString("profiler disabled");
+	}
+	else {
+		const FrameStats& average = profiler.get_average();
+		const FrameStats& peak = profiler.get_peak();
+
+		char buffer[512];
+		std::snprintf(buffer, sizeof(buffer),
+			"            avg     peak\n"
+			"frame   %7.2f  %7.2f ms\n"
+			"events  %7.2f  %7.2f ms\n"
+			"update  %7.2f  %7.2f ms\n"
+			"layout  %7.2f  %7.2f ms\n"
+			"render  %7.2f  %7.2f ms\n"
+			"draws   %7u  %7u\n"
+			"texts   %7u  %7u\n"
+			"allocs  %7zu  %7zu",
+			average.frame_time, peak.frame_time,
+			average.event_time, peak.event_time,
+			average.update_time, peak.update_time,
+			average.layout_time, peak.layout_time,
+			average.render_time, peak.render_time,
+			average.draw_calls, peak.draw_calls,
+			average.text_layouts, peak.text_layouts,
+			average.allocations, peak.allocations);
+		m_text.setString(buffer);
+	}
+	Profiler::get().count_text_layout();
+
+	// One damage rect covering the old and the new background
+	const sf::FloatRect previous = get_bounds();
+	const sf::FloatRect bounds = m_text.getLocalBounds();
+	m_background.setSize(sf::Vector2f(bounds.left + bounds.width + 12.f, bounds.top + bounds.height + 8.f));
+	invalidate_render(unite_rects(previous, get_bounds()));
+}
+
+void ProfilerOverlay::render(sf::RenderTarget& target) {
+	target.draw(m_background);
+	target.draw(m_text);
+}
+
+void ProfilerOverlay::render_batched(RenderBatch& batch) {
+	batch.draw_rectangle(m_background);
+	batch.draw_text(m_text);
+}
+
+void ProfilerOverlay::set_position(const sf::Vector2f& position) {
+	invalidate_render();
+	m_background.setPosition(position);
+	m_text.setPosition(position + sf::Vector2f(6.f, 4.f));
+	invalidate_render();
+}
+
+void ProfilerOverlay::set_size(const sf::Vector2f& size) {}
+
+sf::Vector2f ProfilerOverlay::get_position() const {
+	return m_background.getPosition();
+}
+
+sf::Vector2f ProfilerOverlay::get_size() const {
+	return m_background.getSize();
+}
@@ -0,0 +1,37 @@
+#ifndef PROFILER_OVERLAY_HPP
+#define PROFILER_OVERLAY_HPP
+
+#include "../component.hpp"
+#include "../profiler.hpp"
+
+namespace thd
+{
+
+// Shows the profiler's averages and peaks, refreshed a few times per second so the overlay
+// itself does not dominate the counters it reports
+class ProfilerOverlay : public Component {
+public:
+	ProfilerOverlay(const std::string& identifier, const sf::Font& font, unsigned font_size = 14,
+		const sf::Vector2f& position = sf::Vector2f(0.f, 0.f));
+
+	void update(float dt, const sf::RenderWindow& window) override;
+	void render(sf::RenderTarget& target) override;
+	void render_batched(RenderBatch& batch) override;
+
+	void set_position(const sf::Vector2f& position) override;
+	void set_size(const sf::Vector2f& size) override;
+	sf::Vector2f get_position() const override;
+	sf::Vector2f get_size() const override;
+
+	void set_refresh_interval(float seconds) { m_refresh_interval = seconds; }
+private:
+	void refresh();
+
+	sf::Text m_text;
+	sf::RectangleShape m_background;
+	float m_refresh_interval = 0.5f;
+	float m_elapsed = 0.0f;
+};
+
+} // namespace thd
+#endif // PROFILER_OVERLAY_HPP
@@ -1,10 +1,9 @@
 #include "text_scroll.hpp"
-#include <fstream>
-#include <sstream>
+#include "../font_registry.hpp"
+#include "../profiler.hpp"
 #include <iostream>
-#include <vector>
-
-std::string file_content_temp = "";
+#include <algorithm>
+#include <cmath>
 
 using namespace thd;
 
@@ -13,109 +12,173 @@ TextScroll::TextScroll(const std::string& identifier, const std::string& text, c
 	const sf::Color& font_color, unsigned font_size, const float screen_size_x, const float screen_size_y, const std::string& path, const bool& is_in_fit_container)
 	: Component(identifier), m_size(size), m_position(position), m_screen_size_x(screen_size_x), m_screen_size_y(screen_size_y), 
 	m_is_in_fit_container(is_in_fit_container) {
-	m_text = std::make_shared<sf::Text>();
-	m_text->setFont(font);
-	set_text(text);
-	m_text->setCharacterSize(font_size);
-	m_text->setFillColor(font_color);
-	m_text->setPosition(position);
-
-	m_shape = std::make_shared<sf::RectangleShape>(size);
-	m_shape->setFillColor(background_color);
-	m_shape->setPosition(position);
+	m_text.setFont(font);
+	m_text.setCharacterSize(font_size);
+	m_text.setFillColor(font_color);
+	m_text.setPosition(position);
+
+	m_shape.setSize(size);
+	m_shape.setFillColor(background_color);
+	m_shape.setPosition(position);
+	update_view();
 
+	m_source = TextSource(text);
 	if (path != "none") {
 		load_from_file(path);
 	}
-
-	update_view();
+	if (m_lines.empty() && !m_is_in_fit_container) {
+		rewrap();
+	}
 }
 
 void TextScroll::load_from_file(const std::string& file_path) {
-	std::ifstream file(file_path);
-	if (!file.is_open()) {
+	TextSource source;
+	if (!source.open_file(file_path)) {
 		std::cerr << "Error: Could not open file " << file_path << std::endl;
 		return;
 	}
 
-	std::stringstream buffer;
-	std::string line;
-	while (std::getline(file, line)) {
-		buffer << line << '\n';
-	}
+	set_source(std::move(source));
+}
 
-	std::string file_content = buffer.str();
-	if (file_content.empty()) {
+void TextScroll::set_source(TextSource source) {
+	if (source.empty()) {
 		std::cerr << "File is empty or not readable." << std::endl;
+		return;
 	}
-	else {
-		if (!m_is_in_fit_container)
-			set_text(file_content);
-		else
-			file_content_temp = file_content;
-	}
 
-	file.close();
+	m_source = std::move(source);
+
+	// Text inside a fit container is wrapped once the container assigns its size
+	if (!m_is_in_fit_container || m_size.x > 0.f)
+		rewrap();
 }
 
 void TextScroll::set_text(const std::string& text) {
-	if (m_shape) { 
-		std::string wrapped_text = wrap_text(text, m_shape->getSize().x);
-		m_text->setString(wrapped_text);
+	m_source = TextSource(text);
+	rewrap();
+}
+
+GlyphMetrics& TextScroll::get_metrics() {
+	const sf::Font& font = *m_text.getFont();
+	const unsigned character_size = m_text.getCharacterSize();
+
+	if (GlyphMetrics* shared = FontRegistry::get().find_metrics(font, character_size)) {
+		return *shared;
+	}
+	// Fonts from elsewhere only have to outlive this component
+	if (!m_own_metrics || !m_own_metrics->describes(font, character_size)) {
+		m_own_metrics = std::make_unique<GlyphMetrics>(font, character_size);
 	}
+	return *m_own_metrics;
+}
+
+void TextScroll::rewrap() {
+	wrap_text(m_shape.getSize().x);
+	update_visible_lines(true);
+	invalidate_render();
 }
 
-std::string TextScroll::wrap_text(const std::string& text, const float& width) {
-	std::string result;
-	std::istringstream line_stream(text);
-	std::string line;
+void TextScroll::update_visible_lines(bool force) {
+	const float line_spacing = get_metrics().get_line_spacing();
+	if (line_spacing <= 0.f) return;
 
-	while (std::getline(line_stream, line)) {
-		m_text->setString(line);
+	const float window_top = m_view.getCenter().y - m_view.getSize().y / 2.f - m_position.y;
+	const float first = std::floor(window_top / line_spacing);
+	const std::size_t begin = std::min(m_lines.size(), static_cast<std::size_t>(std::max(0.f, first)));
+	const std::size_t count = static_cast<std::size_t>(std::ceil(m_view.getSize().y / line_spacing)) + 1;
+	const std::size_t end = std::min(m_lines.size(), begin + count);
 
-		if (m_text->getGlobalBounds().width <= width) {
-			result += line + "\n";
-			continue;
+	if (!force && begin == m_visible_begin && end == m_visible_end) return;
+	m_visible_begin = begin;
+	m_visible_end = end;
+
+	std::string visible_text;
+	for (std::size_t i = begin; i < end; ++i) {
+		if (i != begin) {
+			visible_text += '\n';
 		}
+		visible_text.append(m_source.data() + m_lines[i].begin, m_lines[i].length);
+	}
+
+	m_text.setString(visible_text);
+	Profiler::get().count_text_layout();
+	m_text.setPosition(m_position.x, m_position.y + begin * line_spacing);
+}
 
-		std::istringstream word_stream(line);
-		std::string word;
-		std::string current_line;
+void TextScroll::wrap_text(const float& width) {
+	m_lines.clear();
+
+	GlyphMetrics& metrics = get_metrics();
+	const char* const data = m_source.data();
+	const std::vector<std::size_t>& line_offsets = m_source.get_line_offsets();
+	const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+	for (std::size_t index = 0; index < line_offsets.size(); ++index) {
+		const std::size_t line_begin = line_offsets[index];
+		std::size_t line_end = index + 1 < line_offsets.size() ? line_offsets[index + 1] - 1 : m_source.size();
+		if (line_end > line_begin && data[line_end - 1] == '\n') line_end--;
+
+		// Greedy word wrap, every character is measured exactly once
+		const std::size_t first_line = m_lines.size();
+		std::size_t current_begin = 0, current_end = 0;
+		bool has_current = false;
+		float current_width = 0.f, gap_width = 0.f, line_width = 0.f;
+
+		std::size_t pos = line_begin;
+		while (pos < line_end) {
+			const std::size_t gap_begin = pos;
+			while (pos < line_end && is_space(data[pos])) pos++;
+			gap_width = metrics.measure(data + gap_begin, data + pos);
+
+			const std::size_t word_begin = pos;
+			while (pos < line_end && !is_space(data[pos])) pos++;
+			if (word_begin == pos) {
+				line_width += gap_width;
+				break;
+			}
 
-		while (word_stream >> word) {
-			std::string test_line = current_line.empty() ? word : current_line + " " + word;
-			m_text->setString(test_line);
+			const float word_width = metrics.measure(data + word_begin, data + pos);
+			line_width += gap_width + word_width;
 
-			if (m_text->getGlobalBounds().width > width) {
-				result += current_line + "\n";
-				current_line = word;
+			if (!has_current) {
+				current_begin = word_begin;
+				current_width = word_width;
+				has_current = true;
+			}
+			else if (current_width + gap_width + word_width > width) {
+				m_lines.push_back(TextLine{ current_begin, current_end - current_begin });
+				current_begin = word_begin;
+				current_width = word_width;
 			}
 			else {
-				current_line = test_line;
+				current_width += gap_width + word_width;
 			}
+			current_end = pos;
 		}
 
-		if (!current_line.empty()) {
-			result += current_line + "\n";
+		if (line_width <= width) {
+			// The whole line fits, keep it verbatim
+			m_lines.resize(first_line);
+			m_lines.push_back(TextLine{ line_begin, line_end - line_begin });
+		}
+		else if (has_current) {
+			m_lines.push_back(TextLine{ current_begin, current_end - current_begin });
 		}
 	}
-
-	if (!result.empty() && result.back() == '\n') {
-		result.pop_back();
-	}
-
-	return result;
 }
 
 void TextScroll::update(float dt, const sf::RenderWindow& window) {}
 
 void TextScroll::render(sf::RenderTarget& target) {
-	target.draw(*m_shape);
+	target.draw(m_shape);
+
+	update_visible_lines();
 
 	sf::View previousView = target.getView();
 	target.setView(m_view);
 
-	target.draw(*m_text);
+	target.draw(m_text);
 
 	target.setView(previousView);
 }
@@ -140,28 +203,40 @@ void TextScroll::handle_event(const sf::Event& event, sf::RenderWindow& window)
 			else {
 				m_view.move(0, 10.f);
 			}
+			invalidate_render();
 		}
 	}
 }
 
 void TextScroll::set_position(const sf::Vector2f& position) {
 	m_position = position;
-	m_shape->setPosition(position);
-	m_text->setPosition(position);
+	m_shape.setPosition(position);
 
 	update_view();
+	update_visible_lines(true);
+	invalidate_render();
 }
 
 void TextScroll::set_size(const sf::Vector2f& size) {
 	m_size = size;
-	m_shape->setSize(size);
+	m_shape.setSize(size);
+
+	update_view();
+	rewrap();
+}
+
+void TextScroll::set_screen_size(const sf::Vector2f& screen_size) {
+	if (screen_size.x == m_screen_size_x && screen_size.y == m_screen_size_y) return;
+
+	m_screen_size_x = screen_size.x;
+	m_screen_size_y = screen_size.y;
 
-	set_text(file_content_temp);
 	update_view();
+	invalidate_render();
 }
 
 void TextScroll::update_view() {
-	const sf::FloatRect bounds = m_shape->getGlobalBounds();
+	const sf::FloatRect bounds = m_shape.getGlobalBounds();
 
 	m_view.setCenter(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
 	m_view.setSize(bounds.width, bounds.height);
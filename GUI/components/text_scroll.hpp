@@ -2,6 +2,10 @@
 #define TEXT_SCROLL_HPP
 
 #include "../component.hpp"
+#include "../text_source.hpp"
+#include "../glyph_metrics.hpp"
+#include <memory>
+#include <vector>
 
 namespace thd
 {
@@ -15,6 +19,8 @@ public:
 		const float screen_size_x = 800.f, const float screen_size_y = 600.f, const std::string& path = "none", const bool& is_in_fit_container = false);
 
 	void load_from_file(const std::string& file_path);
+	// Replaces the displayed text, e.g. with a file opened by the AssetLoader
+	void set_source(TextSource source);
 	void update(float dt, const sf::RenderWindow& window) override;
 	void render(sf::RenderTarget& target) override;
 	void handle_event(const sf::Event& event, sf::RenderWindow& window) override;
@@ -23,21 +29,40 @@ public:
 	void set_size(const sf::Vector2f& size) override;
 	sf::Vector2f get_position() const override { return m_position; }
 	sf::Vector2f get_size() const override { return m_size; }
+	bool has_own_view() const override { return true; }
+	void set_screen_size(const sf::Vector2f& screen_size) override;
 	void set_text(const std::string& text);
 
 private:
+	// A wrapped line, stored as a range of m_source
+	struct TextLine {
+		std::size_t begin;
+		std::size_t length;
+	};
+
 	sf::View m_view;
-	std::shared_ptr<sf::Text> m_text;
+	sf::Text m_text;
 	sf::Vector2f m_size;
 	sf::Vector2f m_position;
-	std::shared_ptr<sf::RectangleShape> m_shape;
-	const float m_screen_size_x;
-	const float m_screen_size_y;
+	sf::RectangleShape m_shape;
+	float m_screen_size_x;
+	float m_screen_size_y;
 	float m_scroll_offset;
 	bool m_is_in_fit_container;
+	TextSource m_source;
+	std::vector<TextLine> m_lines;
+	// Range of m_lines currently laid out in m_text
+	std::size_t m_visible_begin = 0;
+	std::size_t m_visible_end = 0;
+	// Metrics of a font that is not owned by the FontRegistry
+	std::unique_ptr<GlyphMetrics> m_own_metrics;
 
 	void update_view();
-	std::string wrap_text(const std::string& text, const float& width);
+	GlyphMetrics& get_metrics();
+	void rewrap();
+	// Lays out only the lines intersecting the scroll window
+	void update_visible_lines(bool force = false);
+	void wrap_text(const float& width);
 };
 
 } // namespace thd
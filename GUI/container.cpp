@@ -1,15 +1,25 @@
 #include "container.hpp"
-#include <random>
+#include "component_index.hpp"
+#include "layout_solver.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
 using namespace thd;
 
+// Reused between passes so its arrays keep their capacity, layout only runs on the main thread
+static LayoutSolver& shared_solver() {
+	static LayoutSolver solver;
+	return solver;
+}
+
 Container::Container(AlignmentType alignment_type, FitType fit_type,
 	const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color)
 	: Component("container"), m_alignment_type(alignment_type),
 	m_fit_type(fit_type), m_position(position), m_size(size)
 {
-	m_shape = std::make_shared<sf::RectangleShape>(m_size);
-	m_shape->setPosition(m_position);
-	m_shape->setFillColor(color);
+	m_shape.setSize(m_size);
+	m_shape.setPosition(m_position);
+	m_shape.setFillColor(color);
 }
 
 void Container::update(float dt, const sf::RenderWindow& window) {
@@ -34,32 +44,157 @@ std::shared_ptr<Component> Container::get_component(const std::string& identifie
 }
 
 void Container::render(sf::RenderTarget& target) {
-	if (m_shape) {
-		target.draw(*m_shape);
+	flush_layout();
+
+	RenderBatch batch(target);
+	render_batched(batch);
+}
+
+void Container::render_batched(RenderBatch& batch) {
+	if (m_cached && update_render_cache()) {
+		// The cache holds premultiplied colors
+		batch.draw_sprite(m_cache_sprite, sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha));
+	}
+	else {
+		render_children(batch);
 	}
+	m_render_dirty = false;
+}
+
+void Container::render_children(RenderBatch& batch) {
+	batch.draw_rectangle(m_shape);
 	for (const auto& component : m_components) {
 		if (component) {
-			component->render(target);
+			component->render_batched(batch);
 		}
 	}
 }
 
+bool Container::update_render_cache() {
+	if (m_cache_texture && !m_render_dirty) return true;
+	if (has_own_view()) return false;
+
+	const sf::Vector2u size(static_cast<unsigned>(std::ceil(m_size.x)), static_cast<unsigned>(std::ceil(m_size.y)));
+	if (size.x == 0 || size.y == 0) return false;
+
+	if (!m_cache_texture || m_cache_texture->getSize() != size) {
+		m_cache_texture = std::make_unique<sf::RenderTexture>();
+		if (!m_cache_texture->create(size.x, size.y)) {
+			m_cache_texture.reset();
+			m_cached = false;
+			return false;
+		}
+	}
+
+	m_cache_texture->setView(sf::View(sf::FloatRect(m_position.x, m_position.y,
+		static_cast<float>(size.x), static_cast<float>(size.y))));
+	m_cache_texture->clear(sf::Color::Transparent);
+	{
+		RenderBatch cache_batch(*m_cache_texture);
+		render_children(cache_batch);
+	}
+	m_cache_texture->display();
+
+	m_cache_sprite.setTexture(m_cache_texture->getTexture(), true);
+	m_cache_sprite.setPosition(m_position);
+	return true;
+}
+
+void Container::set_cached(bool cached) {
+	m_cached = cached;
+	if (!m_cached) {
+		m_cache_texture.reset();
+	}
+	invalidate_render();
+}
+
+bool Container::is_cached() const {
+	return m_cached;
+}
+
+void Container::take_damage(std::vector<sf::FloatRect>& damage) {
+	damage.insert(damage.end(), m_damage.begin(), m_damage.end());
+	m_damage.clear();
+}
+
+void Container::on_damage(const sf::FloatRect& area) {
+	if (area.width <= 0.f || area.height <= 0.f) return;
+	// Already redrawing everything, also keeps roots nobody takes the damage from at one entry
+	if (m_damage.size() == 1 && m_damage.front() == FULL_DAMAGE) return;
+
+	// Fold every overlapping rectangle into the new one
+	sf::FloatRect merged = area;
+	for (auto it = m_damage.begin(); it != m_damage.end();) {
+		if (it->intersects(merged)) {
+			merged = unite_rects(*it, merged);
+			it = m_damage.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+	m_damage.push_back(merged);
+
+	// Many scattered rectangles cost more draw passes than one full redraw
+	if (m_damage.size() > 16) {
+		m_damage.assign(1, FULL_DAMAGE);
+	}
+}
+
+bool Container::is_animating() const {
+	for (const auto& component : m_components) {
+		if (component->is_animating()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Container::has_own_view() const {
+	for (const auto& component : m_components) {
+		if (component->has_own_view()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void Container::set_screen_size(const sf::Vector2f& screen_size) {
+	if (m_screen_size == screen_size) return;
+
+	m_screen_size = screen_size;
+	for (const auto& component : m_components) {
+		component->set_screen_size(screen_size);
+	}
+	invalidate_layout();
+}
+
 void Container::set_position(const sf::Vector2f& position) {
 	const sf::Vector2f offset = position - m_position;
 	m_position = position;
-	m_shape->setPosition(m_shape->getPosition() + offset);
+	m_shape.setPosition(m_shape.getPosition() + offset);
 
-	arrange_children();
+	invalidate_layout();
+}
+
+void Container::apply_layout(const sf::Vector2f& position, const sf::Vector2f& size) {
+	if (m_position == position && m_size == size) return;
+
+	// A moved or resized container re-renders its cache and repaints where it was and where it is now
+	const sf::FloatRect previous = get_bounds();
+	m_position = position;
+	m_size = size;
+	m_shape.setPosition(position);
+	m_shape.setSize(size);
+	invalidate_render(unite_rects(previous, get_bounds()));
 }
 
 void Container::set_size(const sf::Vector2f& size) {
 	m_size = size;
 
-	if (m_shape) { 
-		m_shape->setSize(size);
-	}
+	m_shape.setSize(size);
 
-	arrange_children();
+	invalidate_layout();
 }
 
 sf::Vector2f Container::get_position() const {
@@ -71,121 +206,110 @@ sf::Vector2f Container::get_size() const {
 }
 
 void Container::add_component(std::shared_ptr<Component> component) {
+	component->set_parent(this);
+	if (m_screen_size.x > 0.0f && m_screen_size.y > 0.0f) {
+		component->set_screen_size(m_screen_size);
+	}
 	m_components.push_back(component);
-	arrange_children();
+	if (m_index) {
+		m_index->insert(component);
+	}
+
+	if (component->needs_layout()) {
+		mark_descendant_dirty();
+	}
+	invalidate_layout();
 }
 
 void Container::delete_component(const std::string& identifier) {
-	m_components.remove_if([identifier](const std::shared_ptr<Component>& component) {
-		return component->get_identifier() == identifier;
+	const auto removed = std::remove_if(m_components.begin(), m_components.end(), [this, &identifier](const std::shared_ptr<Component>& component) {
+		if (component->get_identifier() == identifier) {
+			if (m_index) {
+				m_index->remove(component);
+			}
+			component->set_parent(nullptr);
+			return true;
+		}
+		return false;
 		});
-	arrange_children();
+	m_components.erase(removed, m_components.end());
+	invalidate_layout();
 }
 
-void Container::arrange_children() {
-	if (m_components.empty()) return;
-
-	if (m_alignment_type == AlignmentType::Vertical) {
-		float current_y = m_position.y;
-		float component_height = m_fit_type == FitType::Fit ?
-			m_size.y / m_components.size() : 0.0f;
+bool Container::flush_layout() {
+	bool arranged = false;
 
+	if (m_layout_dirty) {
+		ProfileScope scope(ProfileSection::Layout);
+		shared_solver().solve(*this);
+		invalidate_render(FULL_DAMAGE);
+		arranged = true;
+	}
+	// Only some subtrees are stale, solve each of them
+	else if (m_has_dirty_descendant) {
 		for (const auto& component : m_components) {
-			sf::Vector2f size = component->get_size();
-			if (m_fit_type == FitType::Fit) {
-				size = sf::Vector2f(m_size.x, component_height);
-			}
-			float component_x = m_position.x;
-			float component_y = current_y;
-
-			switch (component->get_anchor_point()) {
-			case AnchorPoint::Center:
-			case AnchorPoint::TopCenter:
-			case AnchorPoint::BottomCenter:
-				component_x = m_position.x + (m_size.x - size.x) / 2;
-				break;
-			case AnchorPoint::CenterRight:
-			case AnchorPoint::TopRight:
-			case AnchorPoint::BottomRight:
-				component_x = m_position.x + m_size.x - size.x;
-				break;
-			default:
-				component_x = m_position.x;
-				break;
-			}
-
-			sf::Vector2f current_position = component->get_position();
-
-			if (current_position != sf::Vector2f(component_x, component_y)) {
-				component->set_position(sf::Vector2f(component_x, component_y));
-			}
-
-			if (m_fit_type == FitType::Fit) {
-				if (component->get_size() != size) {
-					component->set_size(size);
-				}
+			if (component->needs_layout()) {
+				arranged |= component->flush_layout();
 			}
-
-			current_y += size.y;
 		}
+		m_has_dirty_descendant = false;
 	}
-	else if (m_alignment_type == AlignmentType::Horizontal) {
-		float current_x = m_position.x;
-		float component_width = m_fit_type == FitType::Fit ?
-			m_size.x / m_components.size() : 0.0f;
-
-		for (const auto& component : m_components) {
-			sf::Vector2f size = component->get_size();
-			if (m_fit_type == FitType::Fit) {
-				size = sf::Vector2f(component_width, m_size.y);
-			}
-			float component_x = current_x;
-			float component_y = m_position.y;
-
-			switch (component->get_anchor_point()) {
-			case AnchorPoint::Center:
-			case AnchorPoint::CenterLeft:
-			case AnchorPoint::CenterRight:
-				component_y = m_position.y + (m_size.y - size.y) / 2;
-				break;
-			case AnchorPoint::BottomLeft:
-			case AnchorPoint::BottomCenter:
-			case AnchorPoint::BottomRight:
-				component_y = m_position.y + m_size.y - size.y;
-				break;
-			default:
-				component_y = m_position.y;
-				break;
-			}
 
-			sf::Vector2f current_position = component->get_position();
-
-			if (current_position != sf::Vector2f(component_x, component_y)) {
-				component->set_position(sf::Vector2f(component_x, component_y));
-			}
-
-			if (m_fit_type == FitType::Fit) {
-				if (component->get_size() != size) {
-					component->set_size(size);
-				}
-			}
-
-			current_x += size.x;
-		}
+	if (arranged) {
+		m_layout_version++;
 	}
+	return arranged;
 }
 
-const std::list<std::shared_ptr<Component>>& Container::get_components() const {
+void Container::arrange_children() {
+	ProfileScope scope(ProfileSection::Layout);
+	shared_solver().solve(*this);
+}
+
+const std::vector<std::shared_ptr<Component>>& Container::get_components() const {
 	return m_components;
 }
 
 void Container::clear_components() {
+	for (const auto& component : m_components) {
+		if (m_index) {
+			m_index->remove(component);
+		}
+		component->set_parent(nullptr);
+	}
 	m_components.clear();
+	invalidate_layout();
 }
 
 void Container::set_fit_type(FitType fit_type) {
 	m_fit_type = fit_type;
-	arrange_children();
+	invalidate_layout();
+}
+
+void Container::set_gap(float gap) {
+	m_gap = gap;
+	invalidate_layout();
+}
+
+void Container::set_padding(float padding) {
+	m_padding = padding;
+	invalidate_layout();
+}
+
+void Container::set_index(ComponentIndex* index) {
+	if (m_index == index) return;
+
+	ComponentIndex* previous = m_index;
+	m_index = index;
+
+	for (const auto& component : m_components) {
+		if (previous) {
+			previous->remove(component);
+		}
+		if (m_index) {
+			m_index->insert(component);
+		}
+	}
 }
 
 FitType Container::get_fit_type() const {
@@ -2,11 +2,14 @@
 #define CONTAINER_HPP
 
 #include "component.hpp"
-#include <list>
+#include <cstdint>
+#include <vector>
 
 namespace thd
 {
 
+class ComponentIndex;
+
 enum AlignmentType {
 	Vertical,
 	Horizontal
@@ -14,7 +17,9 @@ enum AlignmentType {
 
 enum FitType {
 	Fit,
-	Default
+	Default,
+	// Children grow and shrink along the alignment axis according to their FlexItem
+	Flex
 };
 
 class Container : public Component {
@@ -23,32 +28,88 @@ public:
 		const sf::Vector2f& position = sf::Vector2f(0.0f, 0.0f),
 		const sf::Vector2f& size = sf::Vector2f(0.0f, 0.0f), const sf::Color& color = sf::Color::White);
 
-	// Automatically arranges the children components based on the alignment type
+	// Automatically arranges the children components based on the alignment type,
+	// together with every container below them
 	void arrange_children();
+	// Stale subtrees are solved by a LayoutSolver in a single pass
+	bool flush_layout() override;
+	void apply_layout(const sf::Vector2f& position, const sf::Vector2f& size) override;
+	// Incremented by every flush_layout() that arranged something in this subtree
+	unsigned get_layout_version() const { return m_layout_version; }
 
 	void update(float dt, const sf::RenderWindow& window) override;
 	void render(sf::RenderTarget& target) override;
+	void render_batched(RenderBatch& batch) override;
 	void handle_event(const sf::Event& event, sf::RenderWindow& window) override;
 
 	void set_position(const sf::Vector2f& position) override;
 	void set_size(const sf::Vector2f& size) override;
 	sf::Vector2f get_position() const override;
 	sf::Vector2f get_size() const override;
+	AlignmentType get_alignment_type() const { return m_alignment_type; }
 	void set_fit_type(FitType fit_type);
 	FitType get_fit_type() const;
+	// Space between children of a flex container
+	void set_gap(float gap);
+	float get_gap() const { return m_gap; }
+	// Space kept free along every edge of a flex container
+	void set_padding(float padding);
+	float get_padding() const { return m_padding; }
+
+	// Renders the subtree into a texture once and reuses it until a child reports a change
+	void set_cached(bool cached);
+	bool is_cached() const;
+	// Containers report whether any descendant draws through its own view
+	bool has_own_view() const override;
+	// Relative sizes of the children resolve against the screen size, set on the main container
+	// and handed down to every component added below it
+	void set_screen_size(const sf::Vector2f& screen_size) override;
+	bool is_animating() const override;
 
 	void add_component(std::shared_ptr<Component> component);
 	void delete_component(const std::string& identifier);
-	const std::list<std::shared_ptr<Component>>& get_components() const;
+	const std::vector<std::shared_ptr<Component>>& get_components() const;
 	void clear_components();
 	std::shared_ptr<Component> get_component(const std::string& identifier) const;
+
+	// Attaches the subtree to an identifier index, components added later are registered automatically
+	void set_index(ComponentIndex* index);
+
+	// Moves the areas damaged since the last call into the vector, only the root of a tree collects damage
+	void take_damage(std::vector<sf::FloatRect>& damage);
+protected:
+	void on_damage(const sf::FloatRect& area) override;
 private:
+	friend class LayoutSolver;
+
+	void render_children(RenderBatch& batch);
+	// Redraws the cache texture if needed, returns false if the subtree cannot be cached
+	bool update_render_cache();
+
 	AlignmentType m_alignment_type;
 	FitType m_fit_type; // Determines if the container should fit its children or not
-	std::list<std::shared_ptr<Component>> m_components;
+	// Contiguous so traversals walk one array
+	std::vector<std::shared_ptr<Component>> m_components;
 	sf::Vector2f m_position;
 	sf::Vector2f m_size;
-	std::shared_ptr<sf::RectangleShape> m_shape;
+	sf::RectangleShape m_shape;
+	unsigned m_layout_version = 0;
+	ComponentIndex* m_index = nullptr;
+	bool m_cached = false;
+	std::unique_ptr<sf::RenderTexture> m_cache_texture;
+	sf::Sprite m_cache_sprite;
+	std::vector<sf::FloatRect> m_damage;
+	float m_gap = 0.0f;
+	float m_padding = 0.0f;
+	sf::Vector2f m_screen_size;
+
+	// Last flex resolution, reused while the available size and the children's flex inputs are unchanged
+	struct MeasureCache {
+		float available = -1.0f;
+		std::uint64_t inputs = 0;
+		std::vector<float> sizes;
+	};
+	MeasureCache m_measure_cache;
 };
 
 } // namespace thd
@@ -0,0 +1,100 @@
+#include "dirty_rect_renderer.hpp"
+#include "profiler.hpp"
+#include <cmath>
+using namespace thd;
+
+DirtyRectRenderer::DirtyRectRenderer(const sf::Color& clear_color) : m_clear_color(clear_color) {}
+
+void DirtyRectRenderer::render(Container& root, sf::RenderTarget& target) {
+	ProfileScope scope(ProfileSection::Render);
+	root.flush_layout();
+	root.take_damage(m_damage);
+
+	const sf::Vector2u size = target.getSize();
+	if (!m_has_back_buffer || m_back_buffer.getSize() != size) {
+		m_has_back_buffer = m_back_buffer.create(size.x, size.y);
+		if (!m_has_back_buffer) {
+			// Without a back buffer every frame is a full redraw
+			m_damage.clear();
+			target.clear(m_clear_color);
+			root.render(target);
+			return;
+		}
+		m_damage.assign(1, Component::FULL_DAMAGE);
+		m_layout_version = root.get_layout_version() + 1;
+	}
+
+	if (root.get_layout_version() != m_layout_version) {
+		m_own_view_components.clear();
+		collect_own_view_components(root);
+		m_layout_version = root.get_layout_version();
+	}
+
+	const sf::FloatRect screen(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y));
+	for (const auto& damage : m_damage) {
+		sf::FloatRect area;
+		if (!expand_to_own_views(damage).intersects(screen, area)) continue;
+
+		const float left = std::floor(area.left);
+		const float top = std::floor(area.top);
+		redraw_area(root, sf::FloatRect(left, top,
+			std::ceil(area.left + area.width) - left, std::ceil(area.top + area.height) - top));
+	}
+	m_damage.clear();
+	m_back_buffer.display();
+	root.clear_redraw();
+
+	const sf::View previous_view = target.getView();
+	// The default view keeps the size the target was created with, the back buffer matches its current size
+	target.setView(sf::View(screen));
+	target.draw(sf::Sprite(m_back_buffer.getTexture()), sf::BlendNone);
+	Profiler::get().count_draw_calls(1);
+	target.setView(previous_view);
+}
+
+void DirtyRectRenderer::collect_own_view_components(const Container& container) {
+	for (const auto& component : container.get_components()) {
+		if (const auto sub_container = std::dynamic_pointer_cast<Container>(component)) {
+			collect_own_view_components(*sub_container);
+		}
+		else if (component->has_own_view()) {
+			m_own_view_components.push_back(component.get());
+		}
+	}
+}
+
+sf::FloatRect DirtyRectRenderer::expand_to_own_views(sf::FloatRect area) const {
+	bool grown = true;
+	while (grown) {
+		grown = false;
+		for (const Component* component : m_own_view_components) {
+			const sf::FloatRect bounds = component->get_bounds();
+			if (!area.intersects(bounds)) continue;
+
+			const sf::FloatRect united = unite_rects(area, bounds);
+			if (united != area) {
+				area = united;
+				grown = true;
+			}
+		}
+	}
+	return area;
+}
+
+void DirtyRectRenderer::redraw_area(Container& root, const sf::FloatRect& area) {
+	const sf::Vector2u size = m_back_buffer.getSize();
+
+	sf::View view(area);
+	view.setViewport(sf::FloatRect(area.left / size.x, area.top / size.y, area.width / size.x, area.height / size.y));
+	m_back_buffer.setView(view);
+
+	sf::RectangleShape background(sf::Vector2f(area.width, area.height));
+	background.setPosition(area.left, area.top);
+	background.setFillColor(m_clear_color);
+	m_back_buffer.draw(background, sf::BlendNone);
+	Profiler::get().count_draw_calls(1);
+
+	RenderBatch batch(m_back_buffer);
+	batch.set_clip(area);
+	root.render_batched(batch);
+}
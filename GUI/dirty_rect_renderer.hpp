@@ -0,0 +1,31 @@
+#ifndef DIRTY_RECT_RENDERER_HPP
+#define DIRTY_RECT_RENDERER_HPP
+
+#include "container.hpp"
+
+namespace thd
+{
+
+// Keeps a persistent back buffer and redraws only the areas damaged since the last frame,
+// each one clipped through its own view, before copying the buffer to the target
+class DirtyRectRenderer {
+public:
+	explicit DirtyRectRenderer(const sf::Color& clear_color = sf::Color::Black);
+
+	void render(Container& root, sf::RenderTarget& target);
+private:
+	void collect_own_view_components(const Container& container);
+	// Components with their own view are always redrawn whole, so the area has to cover them
+	sf::FloatRect expand_to_own_views(sf::FloatRect area) const;
+	void redraw_area(Container& root, const sf::FloatRect& area);
+
+	sf::Color m_clear_color;
+	sf::RenderTexture m_back_buffer;
+	bool m_has_back_buffer = false;
+	unsigned m_layout_version = 0;
+	std::vector<const Component*> m_own_view_components;
+	std::vector<sf::FloatRect> m_damage;
+};
+
+} // namespace thd
+#endif // DIRTY_RECT_RENDERER_HPP
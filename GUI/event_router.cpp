@@ -0,0 +1,123 @@
+#include "event_router.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <unordered_set>
+using namespace thd;
+
+namespace
+{
+
+void append_unique(std::vector<Component*>& target, const std::vector<Component*>& source) {
+	for (Component* component : source) {
+		if (std::find(target.begin(), target.end(), component) == target.end()) {
+			target.push_back(component);
+		}
+	}
+}
+
+} // namespace
+
+EventRouter::EventRouter(std::shared_ptr<Container> root) : m_root(root) {
+	rebuild();
+}
+
+void EventRouter::rebuild() {
+	m_grid.clear();
+	m_components.clear();
+	m_layout_version = m_root->get_layout_version();
+
+	collect(*m_root);
+
+	// Drop hover and focus entries for components that left the tree
+	const std::unordered_set<Component*> alive(m_components.begin(), m_components.end());
+	const auto is_gone = [&alive](Component* component) { return alive.count(component) == 0; };
+	m_hovered.erase(std::remove_if(m_hovered.begin(), m_hovered.end(), is_gone), m_hovered.end());
+	m_focused.erase(std::remove_if(m_focused.begin(), m_focused.end(), is_gone), m_focused.end());
+}
+
+void EventRouter::collect(const Container& container) {
+	for (const auto& component : container.get_components()) {
+		if (const auto sub_container = std::dynamic_pointer_cast<Container>(component)) {
+			collect(*sub_container);
+			continue;
+		}
+
+		m_components.push_back(component.get());
+		m_grid.insert(component.get(), sf::FloatRect(component->get_position(), component->get_size()));
+	}
+}
+
+void EventRouter::route(const sf::Event& event, sf::RenderWindow& window) {
+	ProfileScope scope(ProfileSection::Events);
+	if (m_root->get_layout_version() != m_layout_version) {
+		rebuild();
+	}
+
+	switch (event.type) {
+		case sf::Event::MouseMoved: {
+			route_pointer(event, window, sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
+			break;
+		}
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased: {
+			route_pointer(event, window, sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+			break;
+		}
+		case sf::Event::MouseWheelScrolled: {
+			route_pointer(event, window, sf::Vector2i(event.mouseWheelScroll.x, event.mouseWheelScroll.y));
+			break;
+		}
+		case sf::Event::MouseLeft: {
+			dispatch(m_hovered, event, window);
+			m_hovered.clear();
+			break;
+		}
+		case sf::Event::TextEntered:
+		case sf::Event::KeyPressed:
+		case sf::Event::KeyReleased: {
+			dispatch(m_focused, event, window);
+			break;
+		}
+		default: {
+			dispatch(m_components, event, window);
+			break;
+		}
+	}
+}
+
+void EventRouter::route_pointer(const sf::Event& event, sf::RenderWindow& window, const sf::Vector2i& pixel) {
+	std::vector<Component*> hits;
+	m_grid.query(window.mapPixelToCoords(pixel), hits);
+
+	m_targets = hits;
+	if (event.type == sf::Event::MouseMoved) {
+		append_unique(m_targets, m_hovered);
+		m_hovered = hits;
+	}
+	else if (event.type == sf::Event::MouseButtonPressed) {
+		append_unique(m_targets, m_focused);
+	}
+
+	dispatch(m_targets, event, window);
+
+	if (event.type == sf::Event::MouseButtonPressed) {
+		update_focus();
+	}
+}
+
+void EventRouter::dispatch(const std::vector<Component*>& components, const sf::Event& event, sf::RenderWindow& window) {
+	for (Component* component : components) {
+		component->handle_event(event, window);
+	}
+}
+
+void EventRouter::update_focus() {
+	m_focused.erase(std::remove_if(m_focused.begin(), m_focused.end(),
+		[](Component* component) { return !component->has_focus(); }), m_focused.end());
+
+	for (Component* component : m_targets) {
+		if (component->has_focus() && std::find(m_focused.begin(), m_focused.end(), component) == m_focused.end()) {
+			m_focused.push_back(component);
+		}
+	}
+}
@@ -0,0 +1,37 @@
+#ifndef EVENT_ROUTER_HPP
+#define EVENT_ROUTER_HPP
+
+#include "container.hpp"
+#include "hit_test_grid.hpp"
+
+namespace thd
+{
+
+// Routes window events through a hit-test grid instead of broadcasting them to the whole tree.
+// Pointer events reach the components under the cursor (plus the previously hovered and focused ones
+// so they can react to the cursor leaving), keyboard events reach focused components only
+class EventRouter {
+public:
+	explicit EventRouter(std::shared_ptr<Container> root);
+
+	void route(const sf::Event& event, sf::RenderWindow& window);
+
+	// Rebuilds the hit-test grid from the current layout, called automatically when the layout changes
+	void rebuild();
+private:
+	void collect(const Container& container);
+	void route_pointer(const sf::Event& event, sf::RenderWindow& window, const sf::Vector2i& pixel);
+	void dispatch(const std::vector<Component*>& components, const sf::Event& event, sf::RenderWindow& window);
+	void update_focus();
+
+	std::shared_ptr<Container> m_root;
+	unsigned m_layout_version = 0;
+	HitTestGrid m_grid;
+	std::vector<Component*> m_components;
+	std::vector<Component*> m_hovered;
+	std::vector<Component*> m_focused;
+	std::vector<Component*> m_targets;
+};
+
+} // namespace thd
+#endif // EVENT_ROUTER_HPP
@@ -0,0 +1,40 @@
+#include "font_registry.hpp"
+using namespace thd;
+
+FontRegistry& FontRegistry::get() {
+	static FontRegistry registry;
+	return registry;
+}
+
+FontHandle FontRegistry::load(const std::string& path) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	const auto it = m_fonts.find(path);
+	if (it != m_fonts.end()) {
+		return it->second;
+	}
+
+	auto font = std::make_shared<sf::Font>();
+	if (!font->loadFromFile(path)) {
+		return nullptr;
+	}
+
+	m_fonts.emplace(path, font);
+	m_metrics[font.get()];
+	return font;
+}
+
+GlyphMetrics* FontRegistry::find_metrics(const sf::Font& font, unsigned character_size) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	const auto it = m_metrics.find(&font);
+	if (it == m_metrics.end()) {
+		return nullptr;
+	}
+
+	auto& metrics = it->second[character_size];
+	if (!metrics) {
+		metrics = std::make_unique<GlyphMetrics>(font, character_size);
+	}
+	return metrics.get();
+}
@@ -0,0 +1,40 @@
+#ifndef FONT_REGISTRY_HPP
+#define FONT_REGISTRY_HPP
+
+#include <SFML/Graphics.hpp>
+#include "glyph_metrics.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace thd
+{
+
+// Lightweight shared reference to a registered font
+typedef std::shared_ptr<const sf::Font> FontHandle;
+
+// Process-wide font cache, every font file is loaded once and all components drawing with it
+// share its glyph pages (sf::Font owns the per-size glyph atlases)
+class FontRegistry {
+public:
+	static FontRegistry& get();
+
+	// Returns the font loaded from the path, loading it on first use, nullptr if it cannot be loaded
+	FontHandle load(const std::string& path);
+	// Returns the glyph metrics shared by every user of a registered font at the character size,
+	// nullptr if the font was not loaded through the registry
+	// registered fonts live as long as the registry, so the metrics never outlive their font,
+	// they are not synchronized though and must only be used on the main thread
+	GlyphMetrics* find_metrics(const sf::Font& font, unsigned character_size);
+private:
+	FontRegistry() = default;
+
+	std::mutex m_mutex;
+	std::unordered_map<std::string, FontHandle> m_fonts;
+	std::unordered_map<const sf::Font*, std::map<unsigned, std::unique_ptr<GlyphMetrics>>> m_metrics;
+};
+
+} // namespace thd
+#endif // FONT_REGISTRY_HPP
@@ -0,0 +1,55 @@
+#include "glyph_metrics.hpp"
+using namespace thd;
+
+GlyphMetrics::GlyphMetrics(const sf::Font& font, unsigned character_size)
+	: m_font(font), m_character_size(character_size), m_line_spacing(font.getLineSpacing(character_size)) {
+	m_byte_advances.fill(-1.f);
+}
+
+float GlyphMetrics::advance(sf::Uint32 character) {
+	if (character < m_byte_advances.size()) {
+		float& cached = m_byte_advances[character];
+		if (cached < 0.f) {
+			cached = load_advance(character);
+		}
+		return cached;
+	}
+
+	const auto it = m_advances.find(character);
+	if (it != m_advances.end()) {
+		return it->second;
+	}
+	return m_advances[character] = load_advance(character);
+}
+
+float GlyphMetrics::kerning(sf::Uint32 previous, sf::Uint32 current) {
+	if (previous == 0) return 0.f;
+
+	const sf::Uint64 key = (static_cast<sf::Uint64>(previous) << 32) | current;
+	const auto it = m_kerning.find(key);
+	if (it != m_kerning.end()) {
+		return it->second;
+	}
+	return m_kerning[key] = m_font.getKerning(previous, current, m_character_size);
+}
+
+float GlyphMetrics::measure(const char* begin, const char* end) {
+	float width = 0.f;
+	sf::Uint32 previous = 0;
+
+	for (const char* it = begin; it != end; ++it) {
+		const sf::Uint32 current = static_cast<unsigned char>(*it);
+		width += kerning(previous, current) + advance(current);
+		previous = current;
+	}
+	return width;
+}
+
+float GlyphMetrics::load_advance(sf::Uint32 character) const {
+	if (character == L'\r' || character == L'\n') return 0.f;
+
+	const float whitespace_width = m_font.getGlyph(L' ', m_character_size, false).advance;
+	if (character == L'\t') return whitespace_width * 4;
+
+	return m_font.getGlyph(character, m_character_size, false).advance;
+}
@@ -0,0 +1,40 @@
+#ifndef GLYPH_METRICS_HPP
+#define GLYPH_METRICS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <unordered_map>
+
+namespace thd
+{
+
+// Caches glyph advances and kerning of one font at one character size,
+// so text can be measured without laying out an sf::Text
+// the font must outlive the metrics, which are not synchronized
+class GlyphMetrics {
+public:
+	GlyphMetrics(const sf::Font& font, unsigned character_size);
+
+	bool describes(const sf::Font& font, unsigned character_size) const {
+		return &m_font == &font && m_character_size == character_size;
+	}
+
+	float advance(sf::Uint32 character);
+	float kerning(sf::Uint32 previous, sf::Uint32 current);
+	float get_line_spacing() const { return m_line_spacing; }
+
+	// Width of the characters in [begin, end) following the spacing rules of sf::Text
+	float measure(const char* begin, const char* end);
+private:
+	float load_advance(sf::Uint32 character) const;
+
+	const sf::Font& m_font;
+	unsigned m_character_size;
+	float m_line_spacing;
+	std::array<float, 256> m_byte_advances;
+	std::unordered_map<sf::Uint32, float> m_advances;
+	std::unordered_map<sf::Uint64, float> m_kerning;
+};
+
+} // namespace thd
+#endif // GLYPH_METRICS_HPP
@@ -0,0 +1,45 @@
+#include "hit_test_grid.hpp"
+#include <cmath>
+using namespace thd;
+
+HitTestGrid::HitTestGrid(float cell_size) : m_cell_size(cell_size) {}
+
+void HitTestGrid::clear() {
+	m_cells.clear();
+}
+
+void HitTestGrid::insert(Component* component, const sf::FloatRect& bounds) {
+	if (bounds.width <= 0.f || bounds.height <= 0.f) return;
+
+	const int first_x = cell_index(bounds.left);
+	const int first_y = cell_index(bounds.top);
+	const int last_x = cell_index(bounds.left + bounds.width);
+	const int last_y = cell_index(bounds.top + bounds.height);
+
+	for (int y = first_y; y <= last_y; ++y) {
+		for (int x = first_x; x <= last_x; ++x) {
+			m_cells[cell_key(x, y)].push_back(Entry{ component, bounds });
+		}
+	}
+}
+
+void HitTestGrid::query(const sf::Vector2f& point, std::vector<Component*>& result) const {
+	const auto cell = m_cells.find(cell_key(cell_index(point.x), cell_index(point.y)));
+	if (cell == m_cells.end()) return;
+
+	for (const auto& entry : cell->second) {
+		if (entry.bounds.contains(point)) {
+			result.push_back(entry.component);
+		}
+	}
+}
+
+long long HitTestGrid::cell_key(int cell_x, int cell_y) const {
+	// Shifting a negative signed value is undefined, build the key from the unsigned bit patterns
+	const unsigned long long high = static_cast<unsigned long long>(static_cast<unsigned>(cell_x)) << 32;
+	return static_cast<long long>(high | static_cast<unsigned>(cell_y));
+}
+
+int HitTestGrid::cell_index(float coordinate) const {
+	return static_cast<int>(std::floor(coordinate / m_cell_size));
+}
@@ -0,0 +1,35 @@
+#ifndef HIT_TEST_GRID_HPP
+#define HIT_TEST_GRID_HPP
+
+#include "component.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace thd
+{
+
+// Uniform grid over component bounds, a point query only visits the components of one cell
+class HitTestGrid {
+public:
+	explicit HitTestGrid(float cell_size = 64.f);
+
+	void clear();
+	void insert(Component* component, const sf::FloatRect& bounds);
+
+	// Appends every component whose bounds contain the point, in insertion order
+	void query(const sf::Vector2f& point, std::vector<Component*>& result) const;
+private:
+	struct Entry {
+		Component* component;
+		sf::FloatRect bounds;
+	};
+
+	long long cell_key(int cell_x, int cell_y) const;
+	int cell_index(float coordinate) const;
+
+	float m_cell_size;
+	std::unordered_map<long long, std::vector<Entry>> m_cells;
+};
+
+} // namespace thd
+#endif // HIT_TEST_GRID_HPP
@@ -0,0 +1,326 @@
+#include "layout_solver.hpp"
+#include "container.hpp"
+#include <algorithm>
+#include <cstring>
+using namespace thd;
+
+// Where the anchor places a component within free space, 0 at the start and 1 at the end
+static float anchor_factor(unsigned char anchor, bool horizontal) {
+	// AnchorPoint is laid out row by row, three columns per row
+	return (horizontal ? anchor % 3 : anchor / 3) * 0.5f;
+}
+
+// Percentage and screen sizes follow the parent and the screen, other sizes are kept
+static float resolve_relative(const SizeValue& expression, float parent_size, const sf::Vector2f& screen, float current) {
+	return expression.is_relative() ? expression.resolve(parent_size, screen.x, screen.y, current) : current;
+}
+
+static void hash_value(std::uint64_t& hash, float value) {
+	std::uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	hash = (hash ^ bits) * 1099511628211ull;
+}
+
+bool LayoutSolver::solve(Container& root) {
+	reset();
+	push(&root, &root);
+
+	// The arrays double as the breadth-first queue, a container's children are gathered
+	// right before it is arranged, once its own geometry is final
+	for (std::size_t node = 0; node < m_components.size(); ++node) {
+		Container* container = m_containers[node];
+		if (!container || container->m_components.empty()) continue;
+
+		// A clean container that kept its geometry still has its subtree where the last pass put it,
+		// so the subtree is neither gathered, arranged nor written back
+		if (node != 0 && !container->needs_layout() && !geometry_changed(node)) continue;
+
+		gather_children(node);
+		arrange(node);
+	}
+
+	const bool changed = apply();
+
+	// Everything below the root is solved now, including what apply() reported
+	for (Container* container : m_containers) {
+		if (container) {
+			container->m_layout_dirty = false;
+			container->m_has_dirty_descendant = false;
+		}
+	}
+	return changed;
+}
+
+void LayoutSolver::reset() {
+	m_components.clear();
+	m_containers.clear();
+	m_first_child.clear();
+	m_child_count.clear();
+	m_anchor.clear();
+	m_alignment.clear();
+	m_fit.clear();
+	m_flex.clear();
+	m_width_expression.clear();
+	m_height_expression.clear();
+	m_gap.clear();
+	m_padding.clear();
+	m_x.clear();
+	m_y.clear();
+	m_width.clear();
+	m_height.clear();
+	m_previous_x.clear();
+	m_previous_y.clear();
+	m_previous_width.clear();
+	m_previous_height.clear();
+}
+
+void LayoutSolver::push(Component* component, Container* container) {
+	const sf::Vector2f position = component->get_position();
+	const sf::Vector2f size = component->get_size();
+
+	m_components.push_back(component);
+	m_containers.push_back(container);
+	m_first_child.push_back(0);
+	m_child_count.push_back(NO_CHILDREN);
+	m_anchor.push_back(static_cast<unsigned char>(component->get_anchor_point()));
+	m_alignment.push_back(static_cast<unsigned char>(container ? container->m_alignment_type : AlignmentType::Vertical));
+	m_fit.push_back(static_cast<unsigned char>(container ? container->m_fit_type : FitType::Default));
+	m_flex.push_back(component->get_flex());
+	m_width_expression.push_back(component->get_width_expression());
+	m_height_expression.push_back(component->get_height_expression());
+	m_gap.push_back(container ? container->m_gap : 0.0f);
+	m_padding.push_back(container ? container->m_padding : 0.0f);
+	m_x.push_back(position.x);
+	m_y.push_back(position.y);
+	m_width.push_back(size.x);
+	m_height.push_back(size.y);
+	m_previous_x.push_back(position.x);
+	m_previous_y.push_back(position.y);
+	m_previous_width.push_back(size.x);
+	m_previous_height.push_back(size.y);
+}
+
+void LayoutSolver::gather_children(std::size_t node) {
+	const Container* container = m_containers[node];
+
+	m_first_child[node] = static_cast<unsigned>(m_components.size());
+	m_child_count[node] = static_cast<unsigned>(container->m_components.size());
+	for (const auto& child : container->m_components) {
+		push(child.get(), dynamic_cast<Container*>(child.get()));
+	}
+}
+
+bool LayoutSolver::geometry_changed(std::size_t node) const {
+	return m_x[node] != m_previous_x[node] || m_y[node] != m_previous_y[node]
+		|| m_width[node] != m_previous_width[node] || m_height[node] != m_previous_height[node];
+}
+
+void LayoutSolver::arrange(std::size_t node) {
+	const unsigned first = m_first_child[node];
+	const unsigned last = first + m_child_count[node];
+	const float x = m_x[node];
+	const float y = m_y[node];
+	const float width = m_width[node];
+	const float height = m_height[node];
+	const bool fit = m_fit[node] == FitType::Fit;
+	const sf::Vector2f& screen = m_containers[node]->m_screen_size;
+
+	if (m_fit[node] == FitType::Flex) {
+		const bool vertical = m_alignment[node] == AlignmentType::Vertical;
+		std::vector<float>& main_position = vertical ? m_y : m_x;
+		std::vector<float>& cross_position = vertical ? m_x : m_y;
+		const float padding = m_padding[node];
+		const float cross_start = (vertical ? x : y) + padding;
+		const float cross_space = (vertical ? width : height) - padding * 2;
+		const float inner_main = (vertical ? height : width) - padding * 2;
+		const float main_space = inner_main - m_gap[node] * (m_child_count[node] - 1);
+
+		// The main size is resolved from the basis, the cross size follows the container
+		resolve_flex(node, main_space, inner_main);
+		const std::vector<SizeValue>& cross_expression = vertical ? m_width_expression : m_height_expression;
+		std::vector<float>& cross_size = vertical ? m_width : m_height;
+
+		const std::vector<float>& main_size = vertical ? m_height : m_width;
+		float current = (vertical ? y : x) + padding;
+		for (unsigned child = first; child < last; ++child) {
+			main_position[child] = current;
+			current += main_size[child] + m_gap[node];
+
+			cross_size[child] = resolve_relative(cross_expression[child], cross_space, screen, cross_size[child]);
+			// The anchor aligns the child across the main axis, as in the other modes
+			const float cross_offset = (cross_space - cross_size[child]) * anchor_factor(m_anchor[child], vertical);
+			cross_position[child] = cross_start + cross_offset;
+		}
+	}
+	else if (m_alignment[node] == AlignmentType::Vertical) {
+		const float component_height = fit ? height / m_child_count[node] : 0.0f;
+		float current_y = y;
+
+		for (unsigned child = first; child < last; ++child) {
+			if (fit) {
+				m_width[child] = width;
+				m_height[child] = component_height;
+			}
+			else {
+				m_width[child] = resolve_relative(m_width_expression[child], width, screen, m_width[child]);
+				m_height[child] = resolve_relative(m_height_expression[child], height, screen, m_height[child]);
+			}
+
+			switch (m_anchor[child]) {
+			case AnchorPoint::Center:
+			case AnchorPoint::TopCenter:
+			case AnchorPoint::BottomCenter:
+				m_x[child] = x + (width - m_width[child]) / 2;
+				break;
+			case AnchorPoint::CenterRight:
+			case AnchorPoint::TopRight:
+			case AnchorPoint::BottomRight:
+				m_x[child] = x + width - m_width[child];
+				break;
+			default:
+				m_x[child] = x;
+				break;
+			}
+			m_y[child] = current_y;
+
+			current_y += m_height[child];
+		}
+	}
+	else {
+		const float component_width = fit ? width / m_child_count[node] : 0.0f;
+		float current_x = x;
+
+		for (unsigned child = first; child < last; ++child) {
+			if (fit) {
+				m_width[child] = component_width;
+				m_height[child] = height;
+			}
+			else {
+				m_width[child] = resolve_relative(m_width_expression[child], width, screen, m_width[child]);
+				m_height[child] = resolve_relative(m_height_expression[child], height, screen, m_height[child]);
+			}
+
+			switch (m_anchor[child]) {
+			case AnchorPoint::Center:
+			case AnchorPoint::CenterLeft:
+			case AnchorPoint::CenterRight:
+				m_y[child] = y + (height - m_height[child]) / 2;
+				break;
+			case AnchorPoint::BottomLeft:
+			case AnchorPoint::BottomCenter:
+			case AnchorPoint::BottomRight:
+				m_y[child] = y + height - m_height[child];
+				break;
+			default:
+				m_y[child] = y;
+				break;
+			}
+			m_x[child] = current_x;
+
+			current_x += m_width[child];
+		}
+	}
+}
+
+bool LayoutSolver::apply() {
+	bool changed = false;
+
+	// The root keeps the geometry it was given
+	for (std::size_t node = 1; node < m_components.size(); ++node) {
+		if (!geometry_changed(node)) continue;
+
+		m_components[node]->apply_layout(
+			sf::Vector2f(m_x[node], m_y[node]),
+			sf::Vector2f(m_width[node], m_height[node]));
+		changed = true;
+	}
+	return changed;
+}
+
+void LayoutSolver::resolve_flex(std::size_t node, float available, float inner_size) {
+	const unsigned first = m_first_child[node];
+	const unsigned count = m_child_count[node];
+	const bool vertical = m_alignment[node] == AlignmentType::Vertical;
+	std::vector<float>& main_size = vertical ? m_height : m_width;
+	const std::vector<SizeValue>& main_expression = vertical ? m_height_expression : m_width_expression;
+	const sf::Vector2f& screen = m_containers[node]->m_screen_size;
+
+	m_flex_base.resize(count);
+	std::uint64_t inputs = 14695981039346656037ull;
+	for (unsigned i = 0; i < count; ++i) {
+		const FlexItem& flex = m_flex[first + i];
+		const SizeValue& expression = main_expression[first + i];
+
+		// Without an explicit basis the page's width or height is the basis, never the last pass's result
+		if (flex.basis >= 0.0f) {
+			m_flex_base[i] = flex.basis;
+		}
+		else if (expression.unit != SizeUnit::Unset) {
+			m_flex_base[i] = expression.resolve(inner_size, screen.x, screen.y, 0.0f);
+		}
+		else {
+			m_flex_base[i] = main_size[first + i];
+		}
+
+		hash_value(inputs, m_flex_base[i]);
+		hash_value(inputs, flex.grow);
+		hash_value(inputs, flex.shrink);
+		hash_value(inputs, flex.min_size);
+		hash_value(inputs, flex.max_size);
+	}
+
+	Container::MeasureCache& cache = m_containers[node]->m_measure_cache;
+	if (cache.available == available && cache.inputs == inputs && cache.sizes.size() == count) {
+		std::copy(cache.sizes.begin(), cache.sizes.end(), main_size.begin() + first);
+		return;
+	}
+
+	// Grows or shrinks the unfrozen items, freezing those clamped by their limits until none are
+	m_flex_target.assign(m_flex_base.begin(), m_flex_base.end());
+	m_flex_unclamped.resize(count);
+	m_flex_frozen.assign(count, 0);
+	for (unsigned pass = 0; pass <= count; ++pass) {
+		float free_space = available;
+		for (unsigned i = 0; i < count; ++i) {
+			free_space -= m_flex_frozen[i] ? m_flex_target[i] : m_flex_base[i];
+		}
+
+		// Growing shares by grow factor, shrinking by shrink factor weighted with the basis
+		const bool growing = free_space >= 0.0f;
+		float factors = 0.0f;
+		for (unsigned i = 0; i < count; ++i) {
+			if (m_flex_frozen[i]) continue;
+
+			const FlexItem& flex = m_flex[first + i];
+			factors += growing ? flex.grow : flex.shrink * m_flex_base[i];
+		}
+
+		float violation = 0.0f;
+		for (unsigned i = 0; i < count; ++i) {
+			if (m_flex_frozen[i]) continue;
+
+			const FlexItem& flex = m_flex[first + i];
+			const float factor = growing ? flex.grow : flex.shrink * m_flex_base[i];
+			m_flex_unclamped[i] = m_flex_base[i] + (factors > 0.0f ? free_space * factor / factors : 0.0f);
+			m_flex_target[i] = std::clamp(m_flex_unclamped[i], flex.min_size, std::max(flex.min_size, flex.max_size));
+			violation += m_flex_target[i] - m_flex_unclamped[i];
+		}
+
+		if (violation == 0.0f) break;
+
+		// Items clamped in the direction of the total violation keep their size for the next pass
+		for (unsigned i = 0; i < count; ++i) {
+			if (m_flex_frozen[i]) continue;
+
+			const float clamp = m_flex_target[i] - m_flex_unclamped[i];
+			if ((violation > 0.0f && clamp > 0.0f) || (violation < 0.0f && clamp < 0.0f)) {
+				m_flex_frozen[i] = 1;
+			}
+		}
+	}
+
+	std::copy(m_flex_target.begin(), m_flex_target.end(), main_size.begin() + first);
+	cache.available = available;
+	cache.inputs = inputs;
+	cache.sizes.assign(m_flex_target.begin(), m_flex_target.end());
+}
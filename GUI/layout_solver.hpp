@@ -0,0 +1,69 @@
+#ifndef LAYOUT_SOLVER_HPP
+#define LAYOUT_SOLVER_HPP
+
+#include "component.hpp"
+#include <vector>
+
+namespace thd
+{
+
+class Container;
+
+// Lays out a whole subtree in one pass, the tree is flattened breadth-first into parallel arrays
+// so every container is solved before its children and siblings sit next to each other
+// subtrees of clean containers whose geometry did not change are skipped entirely
+class LayoutSolver {
+public:
+	// Arranges every container below the root and writes the changed positions and sizes back,
+	// returns true if any component moved or was resized
+	bool solve(Container& root);
+private:
+	static constexpr unsigned NO_CHILDREN = 0;
+
+	void reset();
+	void push(Component* component, Container* container);
+	void gather_children(std::size_t node);
+	bool geometry_changed(std::size_t node) const;
+	void arrange(std::size_t node);
+	// Resolves the main axis sizes of a flex container's children, reusing the container's
+	// measure cache when nothing it depends on changed
+	// Percentages of the basis resolve against inner_size, the container's main size without padding
+	void resolve_flex(std::size_t node, float available, float inner_size);
+	bool apply();
+
+	std::vector<Component*> m_components;
+	// Containers only, nullptr for leaves
+	std::vector<Container*> m_containers;
+	std::vector<unsigned> m_first_child;
+	std::vector<unsigned> m_child_count;
+	std::vector<unsigned char> m_anchor;
+	std::vector<unsigned char> m_alignment;
+	std::vector<unsigned char> m_fit;
+	std::vector<FlexItem> m_flex;
+	std::vector<SizeValue> m_width_expression;
+	std::vector<SizeValue> m_height_expression;
+	// Flex containers only
+	std::vector<float> m_gap;
+	std::vector<float> m_padding;
+
+	// Solved geometry
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_width;
+	std::vector<float> m_height;
+
+	// Geometry before the pass, to write back only what changed and to skip unchanged subtrees
+	std::vector<float> m_previous_x;
+	std::vector<float> m_previous_y;
+	std::vector<float> m_previous_width;
+	std::vector<float> m_previous_height;
+
+	// Scratch space of resolve_flex()
+	std::vector<float> m_flex_base;
+	std::vector<float> m_flex_target;
+	std::vector<float> m_flex_unclamped;
+	std::vector<unsigned char> m_flex_frozen;
+};
+
+} // namespace thd
+#endif // LAYOUT_SOLVER_HPP
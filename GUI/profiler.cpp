@@ -0,0 +1,174 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+using namespace thd;
+
+std::atomic<std::size_t> Profiler::s_allocations(0);
+
+#ifdef THORNED_PROFILE_ALLOCATIONS
+// Counts every allocation of the program, the array, nothrow and delete forms forward to these
+void* operator new(std::size_t size) {
+	Profiler::count_allocation();
+	if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	Profiler::count_allocation();
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+	return ::operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+#endif
+
+Profiler& Profiler::get() {
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::set_enabled(bool enabled) {
+	if (m_enabled == enabled) return;
+
+	m_enabled = enabled;
+	m_in_frame = false;
+	m_open_sections.clear();
+	m_current = FrameStats();
+	m_history_count = 0;
+	m_history_next = 0;
+	m_last = m_average = m_peak = FrameStats();
+}
+
+void Profiler::begin_frame() {
+	if (!m_enabled) return;
+
+	m_current = FrameStats();
+	m_open_sections.clear();
+	m_frame_start = m_mark = m_clock.getElapsedTime().asMicroseconds();
+	s_allocations.store(0, std::memory_order_relaxed);
+	m_in_frame = true;
+}
+
+void Profiler::end_frame() {
+	if (!m_enabled || !m_in_frame) return;
+
+	charge_open_section();
+	m_open_sections.clear();
+	m_in_frame = false;
+
+	m_current.frame_time = (m_clock.getElapsedTime().asMicroseconds() - m_frame_start) / 1000.0f;
+	m_current.allocations = s_allocations.exchange(0, std::memory_order_relaxed);
+	m_last = m_current;
+
+	m_history[m_history_next] = m_current;
+	m_history_next = (m_history_next + 1) % HISTORY_SIZE;
+	m_history_count = std::min(m_history_count + 1, HISTORY_SIZE);
+	update_summary();
+}
+
+void Profiler::discard_frame() {
+	if (!m_enabled || !m_in_frame) return;
+
+	m_open_sections.clear();
+	m_in_frame = false;
+	s_allocations.store(0, std::memory_order_relaxed);
+}
+
+void Profiler::begin_section(ProfileSection section) {
+	if (!m_in_frame) return;
+
+	charge_open_section();
+	m_open_sections.push_back(section);
+}
+
+void Profiler::end_section() {
+	if (!m_in_frame || m_open_sections.empty()) return;
+
+	charge_open_section();
+	m_open_sections.pop_back();
+}
+
+float* Profiler::section_time(ProfileSection section) {
+	switch (section) {
+	case ProfileSection::Events:
+		return &m_current.event_time;
+	case ProfileSection::Update:
+		return &m_current.update_time;
+	case ProfileSection::Layout:
+		return &m_current.layout_time;
+	case ProfileSection::Render:
+		return &m_current.render_time;
+	default:
+		return nullptr;
+	}
+}
+
+void Profiler::charge_open_section() {
+	const sf::Int64 now = m_clock.getElapsedTime().asMicroseconds();
+	if (!m_open_sections.empty()) {
+		if (float* time = section_time(m_open_sections.back())) {
+			*time += (now - m_mark) / 1000.0f;
+		}
+	}
+	m_mark = now;
+}
+
+void Profiler::update_summary() {
+	FrameStats sum;
+	m_peak = FrameStats();
+
+	for (std::size_t i = 0; i < m_history_count; ++i) {
+		const FrameStats& frame = m_history[i];
+		sum.frame_time += frame.frame_time;
+		sum.event_time += frame.event_time;
+		sum.update_time += frame.update_time;
+		sum.layout_time += frame.layout_time;
+		sum.render_time += frame.render_time;
+		sum.draw_calls += frame.draw_calls;
+		sum.text_layouts += frame.text_layouts;
+		sum.allocations += frame.allocations;
+
+		m_peak.frame_time = std::max(m_peak.frame_time, frame.frame_time);
+		m_peak.event_time = std::max(m_peak.event_time, frame.event_time);
+		m_peak.update_time = std::max(m_peak.update_time, frame.update_time);
+		m_peak.layout_time = std::max(m_peak.layout_time, frame.layout_time);
+		m_peak.render_time = std::max(m_peak.render_time, frame.render_time);
+		m_peak.draw_calls = std::max(m_peak.draw_calls, frame.draw_calls);
+		m_peak.text_layouts = std::max(m_peak.text_layouts, frame.text_layouts);
+		m_peak.allocations = std::max(m_peak.allocations, frame.allocations);
+	}
+
+	const float count = static_cast<float>(m_history_count);
+	m_average.frame_time = sum.frame_time / count;
+	m_average.event_time = sum.event_time / count;
+	m_average.update_time = sum.update_time / count;
+	m_average.layout_time = sum.layout_time / count;
+	m_average.render_time = sum.render_time / count;
+	m_average.draw_calls = static_cast<unsigned>(sum.draw_calls / m_history_count);
+	m_average.text_layouts = static_cast<unsigned>(sum.text_layouts / m_history_count);
+	m_average.allocations = sum.allocations / m_history_count;
+}
@@ -0,0 +1,110 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace thd
+{
+
+enum class ProfileSection : unsigned char {
+	Events,
+	Update,
+	Layout,
+	Render,
+	Count
+};
+
+// What one frame cost, times are in milliseconds
+struct FrameStats {
+	float frame_time = 0.0f;
+	float event_time = 0.0f;
+	float update_time = 0.0f;
+	float layout_time = 0.0f;
+	float render_time = 0.0f;
+	unsigned draw_calls = 0;
+	// sf::Text::setString calls, each one lays the glyphs out again
+	unsigned text_layouts = 0;
+	// Heap allocations on any thread, always 0 unless built with THORNED_PROFILE_ALLOCATIONS
+	std::size_t allocations = 0;
+};
+
+// Per-frame timings and counters of the main thread, disabled by default
+// sections nest, a section's time excludes the sections started inside it
+class Profiler {
+public:
+	static Profiler& get();
+
+	void set_enabled(bool enabled);
+	bool is_enabled() const { return m_enabled; }
+
+	void begin_frame();
+	void end_frame();
+	// Ends the frame without recording it
+	void discard_frame();
+
+	void begin_section(ProfileSection section);
+	void end_section();
+
+	void count_draw_calls(unsigned count) { if (m_enabled) m_current.draw_calls += count; }
+	void count_text_layout() { if (m_enabled) m_current.text_layouts++; }
+	// Called from the global operator new, safe on any thread
+	static void count_allocation() { s_allocations.fetch_add(1, std::memory_order_relaxed); }
+
+	const FrameStats& get_last_frame() const { return m_last; }
+	// Average over the last HISTORY_SIZE frames
+	const FrameStats& get_average() const { return m_average; }
+	// Largest value of every field over the last HISTORY_SIZE frames
+	const FrameStats& get_peak() const { return m_peak; }
+
+	static constexpr std::size_t HISTORY_SIZE = 120;
+private:
+	Profiler() = default;
+
+	float* section_time(ProfileSection section);
+	// Charges the time since the last mark to the innermost open section
+	void charge_open_section();
+	void update_summary();
+
+	static std::atomic<std::size_t> s_allocations;
+
+	bool m_enabled = false;
+	bool m_in_frame = false;
+	sf::Clock m_clock;
+	sf::Int64 m_frame_start = 0;
+	sf::Int64 m_mark = 0;
+	std::vector<ProfileSection> m_open_sections;
+	FrameStats m_current;
+	FrameStats m_last;
+	FrameStats m_average;
+	FrameStats m_peak;
+	std::array<FrameStats, HISTORY_SIZE> m_history;
+	std::size_t m_history_next = 0;
+	std::size_t m_history_count = 0;
+};
+
+// Times the enclosing block as a section of the current frame
+class ProfileScope {
+public:
+	explicit ProfileScope(ProfileSection section) : m_active(Profiler::get().is_enabled()) {
+		if (m_active) {
+			Profiler::get().begin_section(section);
+		}
+	}
+	~ProfileScope() {
+		if (m_active) {
+			Profiler::get().end_section();
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+	bool m_active;
+};
+
+} // namespace thd
+#endif // PROFILER_HPP
@@ -0,0 +1,178 @@
+#include "render_batch.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstdlib>
+using namespace thd;
+
+RenderBatch::RenderBatch(sf::RenderTarget& target) : m_target(target) {}
+
+RenderBatch::~RenderBatch() {
+	flush();
+	Profiler::get().count_draw_calls(m_draw_calls);
+}
+
+void RenderBatch::draw_rectangle(const sf::RectangleShape& shape) {
+	if (!is_visible(shape.getGlobalBounds())) return;
+
+	if (shape.getTexture() || shape.getOutlineThickness() != 0.f) {
+		flush();
+		m_target.draw(shape);
+		m_draw_calls++;
+		return;
+	}
+
+	const sf::Vector2f& size = shape.getSize();
+	append_quad(shape.getTransform(), sf::FloatRect(0.f, 0.f, size.x, size.y),
+		sf::FloatRect(), shape.getFillColor());
+	submit_quads(nullptr);
+}
+
+void RenderBatch::draw_sprite(const sf::Sprite& sprite, const sf::BlendMode& blend_mode) {
+	const sf::Texture* texture = sprite.getTexture();
+	if (!texture || !is_visible(sprite.getGlobalBounds())) return;
+
+	const sf::IntRect& rect = sprite.getTextureRect();
+	append_quad(sprite.getTransform(),
+		sf::FloatRect(0.f, 0.f, static_cast<float>(std::abs(rect.width)), static_cast<float>(std::abs(rect.height))),
+		sf::FloatRect(rect), sprite.getColor());
+	submit_quads(texture, blend_mode);
+}
+
+void RenderBatch::draw_text(const sf::Text& text) {
+	const sf::Font* font = text.getFont();
+	if (!font || !is_visible(text.getGlobalBounds())) return;
+
+	if (text.getStyle() != sf::Text::Regular || text.getOutlineThickness() != 0.f) {
+		flush();
+		m_target.draw(text);
+		m_draw_calls++;
+		return;
+	}
+
+	// Mirrors the glyph placement of sf::Text
+	const unsigned character_size = text.getCharacterSize();
+	const float whitespace_advance = font->getGlyph(L' ', character_size, false).advance;
+	const float letter_spacing = (whitespace_advance / 3.f) * (text.getLetterSpacing() - 1.f);
+	const float whitespace_width = whitespace_advance + letter_spacing;
+	const float line_spacing = font->getLineSpacing(character_size) * text.getLineSpacing();
+	const sf::Transform& transform = text.getTransform();
+	const sf::Color& color = text.getFillColor();
+	const float padding = 1.f;
+
+	float x = 0.f;
+	float y = static_cast<float>(character_size);
+	sf::Uint32 previous = 0;
+
+	for (const sf::Uint32 current : text.getString()) {
+		if (current == L'\r') continue;
+
+		x += font->getKerning(previous, current, character_size);
+		previous = current;
+
+		if (current == L' ') {
+			x += whitespace_width;
+			continue;
+		}
+		if (current == L'\t') {
+			x += whitespace_width * 4;
+			continue;
+		}
+		if (current == L'\n') {
+			y += line_spacing;
+			x = 0.f;
+			continue;
+		}
+
+		const sf::Glyph& glyph = font->getGlyph(current, character_size, false);
+		const sf::FloatRect& bounds = glyph.bounds;
+		const sf::IntRect& texture_rect = glyph.textureRect;
+
+		append_quad(transform,
+			sf::FloatRect(x + bounds.left - padding, y + bounds.top - padding,
+				bounds.width + 2 * padding, bounds.height + 2 * padding),
+			sf::FloatRect(texture_rect.left - padding, texture_rect.top - padding,
+				texture_rect.width + 2 * padding, texture_rect.height + 2 * padding),
+			color);
+
+		x += glyph.advance + letter_spacing;
+	}
+
+	submit_quads(&font->getTexture(character_size));
+}
+
+void RenderBatch::flush() {
+	for (const auto& batch : m_batches) {
+		if (batch.vertices.getVertexCount() == 0) continue;
+
+		sf::RenderStates states(batch.blend_mode);
+		states.texture = batch.texture;
+		m_target.draw(batch.vertices, states);
+		m_draw_calls++;
+	}
+	m_batches.clear();
+}
+
+void RenderBatch::set_clip(const sf::FloatRect& clip) {
+	m_has_clip = true;
+	m_clip = clip;
+}
+
+bool RenderBatch::is_visible(const sf::FloatRect& bounds) const {
+	return !m_has_clip || m_clip.intersects(bounds);
+}
+
+sf::VertexArray& RenderBatch::find_batch(const sf::Texture* texture, const sf::BlendMode& blend_mode, const sf::FloatRect& bounds) {
+	// Walk back from the newest batch, joining a batch with the same texture is only
+	// allowed if nothing drawn after it overlaps the new geometry
+	for (auto it = m_batches.rbegin(); it != m_batches.rend(); ++it) {
+		if (it->texture == texture && it->blend_mode == blend_mode) {
+			it->bounds = unite_rects(it->bounds, bounds);
+			return it->vertices;
+		}
+		if (it->bounds.intersects(bounds)) {
+			break;
+		}
+	}
+
+	m_batches.push_back(Batch{ texture, blend_mode, sf::VertexArray(sf::Triangles), bounds });
+	return m_batches.back().vertices;
+}
+
+void RenderBatch::append_quad(const sf::Transform& transform, const sf::FloatRect& rect,
+	const sf::FloatRect& texture_rect, const sf::Color& color) {
+	const float right = rect.left + rect.width;
+	const float bottom = rect.top + rect.height;
+	const float u_right = texture_rect.left + texture_rect.width;
+	const float v_bottom = texture_rect.top + texture_rect.height;
+
+	const sf::Vertex top_left(transform.transformPoint(rect.left, rect.top), color, sf::Vector2f(texture_rect.left, texture_rect.top));
+	const sf::Vertex top_right(transform.transformPoint(right, rect.top), color, sf::Vector2f(u_right, texture_rect.top));
+	const sf::Vertex bottom_left(transform.transformPoint(rect.left, bottom), color, sf::Vector2f(texture_rect.left, v_bottom));
+	const sf::Vertex bottom_right(transform.transformPoint(right, bottom), color, sf::Vector2f(u_right, v_bottom));
+
+	m_quads.push_back(top_left);
+	m_quads.push_back(top_right);
+	m_quads.push_back(bottom_left);
+	m_quads.push_back(bottom_left);
+	m_quads.push_back(top_right);
+	m_quads.push_back(bottom_right);
+}
+
+void RenderBatch::submit_quads(const sf::Texture* texture, const sf::BlendMode& blend_mode) {
+	if (m_quads.empty()) return;
+
+	float left = m_quads.front().position.x, right = left;
+	float top = m_quads.front().position.y, bottom = top;
+	for (const auto& vertex : m_quads) {
+		left = std::min(left, vertex.position.x);
+		right = std::max(right, vertex.position.x);
+		top = std::min(top, vertex.position.y);
+		bottom = std::max(bottom, vertex.position.y);
+	}
+
+	sf::VertexArray& vertices = find_batch(texture, blend_mode, sf::FloatRect(left, top, right - left, bottom - top));
+	for (const auto& vertex : m_quads) {
+		vertices.append(vertex);
+	}
+	m_quads.clear();
+}
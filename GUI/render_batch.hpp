@@ -0,0 +1,63 @@
+#ifndef RENDER_BATCH_HPP
+#define RENDER_BATCH_HPP
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace thd
+{
+
+// Smallest rectangle containing both rectangles
+inline sf::FloatRect unite_rects(const sf::FloatRect& a, const sf::FloatRect& b) {
+	const float left = std::min(a.left, b.left);
+	const float top = std::min(a.top, b.top);
+	const float right = std::max(a.left + a.width, b.left + b.width);
+	const float bottom = std::max(a.top + a.height, b.top + b.height);
+	return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+// Collects rectangles, sprites and glyph quads into shared vertex arrays keyed by texture,
+// so a whole component tree is submitted in a handful of draw calls
+class RenderBatch {
+public:
+	explicit RenderBatch(sf::RenderTarget& target);
+	~RenderBatch();
+
+	void draw_rectangle(const sf::RectangleShape& shape);
+	void draw_sprite(const sf::Sprite& sprite, const sf::BlendMode& blend_mode = sf::BlendAlpha);
+	void draw_text(const sf::Text& text);
+
+	// Submits every pending batch to the target
+	void flush();
+
+	// Restricts drawing to an area, components entirely outside it are skipped
+	void set_clip(const sf::FloatRect& clip);
+	bool is_visible(const sf::FloatRect& bounds) const;
+
+	sf::RenderTarget& get_target() { return m_target; }
+	unsigned get_draw_calls() const { return m_draw_calls; }
+private:
+	struct Batch {
+		const sf::Texture* texture;
+		sf::BlendMode blend_mode;
+		sf::VertexArray vertices;
+		sf::FloatRect bounds;
+	};
+
+	// Returns the batch new geometry can join without being drawn out of order
+	sf::VertexArray& find_batch(const sf::Texture* texture, const sf::BlendMode& blend_mode, const sf::FloatRect& bounds);
+	void append_quad(const sf::Transform& transform, const sf::FloatRect& rect,
+		const sf::FloatRect& texture_rect, const sf::Color& color);
+	void submit_quads(const sf::Texture* texture, const sf::BlendMode& blend_mode = sf::BlendAlpha);
+
+	sf::RenderTarget& m_target;
+	std::vector<Batch> m_batches;
+	std::vector<sf::Vertex> m_quads;
+	unsigned m_draw_calls = 0;
+	bool m_has_clip = false;
+	sf::FloatRect m_clip;
+};
+
+} // namespace thd
+#endif // RENDER_BATCH_HPP
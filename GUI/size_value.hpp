@@ -0,0 +1,44 @@
+#ifndef SIZE_VALUE_HPP
+#define SIZE_VALUE_HPP
+
+namespace thd
+{
+
+enum class SizeUnit : unsigned char {
+	Unset,
+	Pixels,
+	Percent,
+	ScreenX,
+	ScreenY
+};
+
+// A width or height as written in the page, relative ones are resolved against the parent
+// and screen size by every layout pass
+struct SizeValue {
+	SizeUnit unit = SizeUnit::Unset;
+	float value = 0.0f;
+
+	float resolve(float parent_size, float screen_size_x, float screen_size_y, float fallback) const {
+		switch (unit) {
+		case SizeUnit::Pixels:
+			return value;
+		case SizeUnit::Percent:
+			return (value / 100.0f) * parent_size;
+		case SizeUnit::ScreenX:
+			return screen_size_x;
+		case SizeUnit::ScreenY:
+			return screen_size_y;
+		default:
+			return fallback;
+		}
+	}
+
+	// Whether the resolved size changes with the parent or the screen
+	bool is_relative() const { return unit == SizeUnit::Percent || unit == SizeUnit::ScreenX || unit == SizeUnit::ScreenY; }
+
+	bool operator==(const SizeValue& other) const { return unit == other.unit && value == other.value; }
+	bool operator!=(const SizeValue& other) const { return !(*this == other); }
+};
+
+} // namespace thd
+#endif // SIZE_VALUE_HPP
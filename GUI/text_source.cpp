@@ -0,0 +1,166 @@
+#include "text_source.hpp"
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace thd;
+
+TextSource::TextSource(std::string text) : m_buffer(std::move(text)) {
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+	index_lines();
+}
+
+TextSource::~TextSource() {
+	unmap();
+}
+
+TextSource::TextSource(TextSource&& other) noexcept {
+	*this = std::move(other);
+}
+
+TextSource& TextSource::operator=(TextSource&& other) noexcept {
+	if (this == &other) return *this;
+
+	unmap();
+	m_buffer = std::move(other.m_buffer);
+	m_size = other.m_size;
+	m_data = other.m_mapping ? other.m_data : m_buffer.data();
+	m_mapping = other.m_mapping;
+#ifdef _WIN32
+	m_file_handle = other.m_file_handle;
+	m_mapping_handle = other.m_mapping_handle;
+	other.m_file_handle = nullptr;
+	other.m_mapping_handle = nullptr;
+#endif
+	m_line_offsets = std::move(other.m_line_offsets);
+
+	other.m_mapping = nullptr;
+	other.m_data = nullptr;
+	other.m_size = 0;
+	return *this;
+}
+
+bool TextSource::open_file(const std::string& path) {
+	unmap();
+	m_buffer.clear();
+	m_data = nullptr;
+	m_size = 0;
+
+	if (!map_file(path)) {
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) return false;
+
+		m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+		file.seekg(0);
+		if (!m_buffer.empty() && !file.read(&m_buffer[0], static_cast<std::streamsize>(m_buffer.size()))) {
+			m_buffer.clear();
+			return false;
+		}
+
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+	}
+
+	index_lines();
+	return true;
+}
+
+#ifdef _WIN32
+bool TextSource::map_file(const std::string& path) {
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_file_handle = file;
+	m_mapping_handle = mapping;
+	m_mapping = view;
+	m_data = static_cast<const char*>(view);
+	m_size = static_cast<std::size_t>(file_size.QuadPart);
+	return true;
+}
+
+void TextSource::unmap() {
+	if (m_mapping) {
+		UnmapViewOfFile(m_mapping);
+		CloseHandle(m_mapping_handle);
+		CloseHandle(m_file_handle);
+		m_mapping = nullptr;
+		m_mapping_handle = nullptr;
+		m_file_handle = nullptr;
+	}
+}
+#else
+bool TextSource::map_file(const std::string& path) {
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) return false;
+
+	struct stat file_stat;
+	if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0) {
+		close(file);
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED) return false;
+
+	m_mapping = view;
+	m_data = static_cast<const char*>(view);
+	m_size = static_cast<std::size_t>(file_stat.st_size);
+	return true;
+}
+
+void TextSource::unmap() {
+	if (m_mapping) {
+		munmap(m_mapping, m_size);
+		m_mapping = nullptr;
+	}
+}
+#endif
+
+void TextSource::index_lines() {
+	m_line_offsets.clear();
+	if (m_size == 0) return;
+
+	m_line_offsets.push_back(0);
+	const char* it = m_data;
+	const char* const end = m_data + m_size;
+	while ((it = static_cast<const char*>(std::memchr(it, '\n', end - it))) != nullptr) {
+		++it;
+		if (it == end) break;
+		m_line_offsets.push_back(static_cast<std::size_t>(it - m_data));
+	}
+}
@@ -0,0 +1,50 @@
+#ifndef TEXT_SOURCE_HPP
+#define TEXT_SOURCE_HPP
+
+#include <string>
+#include <vector>
+
+namespace thd
+{
+
+// Read-only text that is either memory-mapped from a file or owned in memory,
+// together with the offsets of its lines
+class TextSource {
+public:
+	TextSource() = default;
+	explicit TextSource(std::string text);
+	~TextSource();
+
+	TextSource(TextSource&& other) noexcept;
+	TextSource& operator=(TextSource&& other) noexcept;
+	TextSource(const TextSource&) = delete;
+	TextSource& operator=(const TextSource&) = delete;
+
+	// Maps the file into memory, falls back to reading it in one pass when mapping is unavailable
+	bool open_file(const std::string& path);
+
+	const char* data() const { return m_data; }
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	bool is_mapped() const { return m_mapping != nullptr; }
+
+	// Offset of the first character of every line
+	const std::vector<std::size_t>& get_line_offsets() const { return m_line_offsets; }
+private:
+	bool map_file(const std::string& path);
+	void unmap();
+	void index_lines();
+
+	const char* m_data = nullptr;
+	std::size_t m_size = 0;
+	std::string m_buffer;
+	void* m_mapping = nullptr;
+#ifdef _WIN32
+	void* m_file_handle = nullptr;
+	void* m_mapping_handle = nullptr;
+#endif
+	std::vector<std::size_t> m_line_offsets;
+};
+
+} // namespace thd
+#endif // TEXT_SOURCE_HPP
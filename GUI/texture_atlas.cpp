@@ -0,0 +1,120 @@
+#include "texture_atlas.hpp"
+#include <algorithm>
+using namespace thd;
+
+// Transparent border kept around each image so filtering never samples a neighbour
+static const unsigned ATLAS_PADDING = 1;
+
+TextureAtlas& TextureAtlas::get() {
+	static TextureAtlas atlas;
+	return atlas;
+}
+
+bool TextureAtlas::add(const std::string& path, const sf::Image& image, AtlasRegion& region) {
+	if (find(path, region)) return true;
+
+	const sf::Vector2u size = image.getSize();
+	if (size.x == 0 || size.y == 0 || size.x > MAX_IMAGE_SIZE || size.y > MAX_IMAGE_SIZE) {
+		return false;
+	}
+
+	const unsigned width = size.x + ATLAS_PADDING * 2;
+	const unsigned height = size.y + ATLAS_PADDING * 2;
+
+	release_unused_pages();
+
+	sf::Vector2u position;
+	std::shared_ptr<sf::Texture> texture;
+	for (auto& candidate : m_pages) {
+		if (insert(candidate, width, height, position)) {
+			texture = candidate.texture.lock();
+			break;
+		}
+	}
+
+	if (!texture) {
+		texture = std::make_shared<sf::Texture>();
+		if (!texture->create(PAGE_SIZE, PAGE_SIZE)) {
+			return false;
+		}
+		// Pages start with undefined contents, clear them so the padding stays transparent
+		sf::Image blank;
+		blank.create(PAGE_SIZE, PAGE_SIZE, sf::Color::Transparent);
+		texture->update(blank);
+
+		Page created;
+		created.texture = texture;
+		insert(created, width, height, position);
+		m_pages.push_back(std::move(created));
+	}
+
+	texture->update(image, position.x + ATLAS_PADDING, position.y + ATLAS_PADDING);
+
+	const sf::IntRect rect(
+		static_cast<int>(position.x + ATLAS_PADDING),
+		static_cast<int>(position.y + ATLAS_PADDING),
+		static_cast<int>(size.x),
+		static_cast<int>(size.y));
+	m_regions[path] = Placement{ texture, rect };
+
+	region = AtlasRegion{ texture, rect };
+	return true;
+}
+
+bool TextureAtlas::find(const std::string& path, AtlasRegion& region) {
+	const auto it = m_regions.find(path);
+	if (it == m_regions.end()) return false;
+
+	TextureHandle texture = it->second.page.lock();
+	if (!texture) {
+		m_regions.erase(it);
+		return false;
+	}
+
+	region = AtlasRegion{ texture, it->second.rect };
+	return true;
+}
+
+std::size_t TextureAtlas::get_page_count() {
+	release_unused_pages();
+	return m_pages.size();
+}
+
+void TextureAtlas::release_unused_pages() {
+	const auto unused = [](const Page& page) { return page.texture.expired(); };
+	if (std::none_of(m_pages.begin(), m_pages.end(), unused)) return;
+
+	m_pages.erase(std::remove_if(m_pages.begin(), m_pages.end(), unused), m_pages.end());
+	for (auto it = m_regions.begin(); it != m_regions.end();) {
+		if (it->second.page.expired()) {
+			it = m_regions.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+bool TextureAtlas::insert(Page& page, unsigned width, unsigned height, sf::Vector2u& position) {
+	Shelf* best = nullptr;
+	for (auto& shelf : page.shelves) {
+		if (height <= shelf.height && shelf.x + width <= PAGE_SIZE) {
+			if (!best || shelf.height < best->height) {
+				best = &shelf;
+			}
+		}
+	}
+
+	if (!best) {
+		if (page.next_y + height > PAGE_SIZE || width > PAGE_SIZE) {
+			return false;
+		}
+		page.shelves.push_back({ page.next_y, height, 0 });
+		page.next_y += height;
+		best = &page.shelves.back();
+	}
+
+	position = sf::Vector2u(best->x, best->y);
+	best->x += width;
+	return true;
+}
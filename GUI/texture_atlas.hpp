@@ -0,0 +1,67 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include "texture_cache.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace thd
+{
+
+// Location of a packed image inside an atlas page
+struct AtlasRegion {
+	TextureHandle texture;
+	sf::IntRect rect;
+};
+
+// Packs small images into shared texture pages, so components displaying them
+// draw from one texture and batch together
+// a page lives as long as a region handed out from it, pages nobody draws from are dropped
+// together with their regions, so rebuilt pages do not accumulate
+class TextureAtlas {
+public:
+	static const unsigned PAGE_SIZE = 1024;
+	// Larger images keep a texture of their own
+	static const unsigned MAX_IMAGE_SIZE = 256;
+
+	static TextureAtlas& get();
+
+	// Packs the decoded image into a page and returns its region, false if it is too large
+	bool add(const std::string& path, const sf::Image& image, AtlasRegion& region);
+	// Region of a packed image, false if the path was never packed or its page was released
+	bool find(const std::string& path, AtlasRegion& region);
+
+	std::size_t get_page_count();
+private:
+	TextureAtlas() = default;
+
+	struct Shelf {
+		unsigned y;
+		unsigned height;
+		unsigned x;
+	};
+
+	struct Page {
+		std::weak_ptr<sf::Texture> texture;
+		std::vector<Shelf> shelves;
+		unsigned next_y = 0;
+	};
+
+	struct Placement {
+		std::weak_ptr<sf::Texture> page;
+		sf::IntRect rect;
+	};
+
+	// Finds room on the shelf wasting the least height, opens a new shelf otherwise
+	static bool insert(Page& page, unsigned width, unsigned height, sf::Vector2u& position);
+	// Forgets pages no region is used from anymore
+	void release_unused_pages();
+
+	std::vector<Page> m_pages;
+	std::unordered_map<std::string, Placement> m_regions;
+};
+
+} // namespace thd
+#endif // TEXTURE_ATLAS_HPP
@@ -0,0 +1,173 @@
+#include "texture_cache.hpp"
+#include <algorithm>
+using namespace thd;
+
+TextureCache& TextureCache::get() {
+	static TextureCache cache;
+	return cache;
+}
+
+TextureHandle TextureCache::load(const std::string& path) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (TextureHandle texture = find(path)) {
+			return texture;
+		}
+	}
+
+	// Decoded without the lock so loads of different files run in parallel
+	auto texture = std::make_shared<sf::Texture>();
+	if (!texture->loadFromFile(path)) {
+		return nullptr;
+	}
+	return publish(path, texture);
+}
+
+TextureHandle TextureCache::insert(const std::string& path, const sf::Image& image) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (TextureHandle texture = find(path)) {
+			return texture;
+		}
+	}
+
+	auto texture = std::make_shared<sf::Texture>();
+	if (!texture->loadFromImage(image)) {
+		return nullptr;
+	}
+	return publish(path, texture);
+}
+
+std::size_t TextureCache::get_retained_bytes() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::size_t bytes = 0;
+	for (const auto& entry : m_retained) {
+		if (entry.texture.use_count() == 1) {
+			bytes += entry.bytes;
+		}
+	}
+	return bytes;
+}
+
+void TextureCache::set_budget(std::size_t bytes) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_budget = bytes;
+	if (m_budget == 0) {
+		m_retained.clear();
+		m_retained_lookup.clear();
+	}
+	trim();
+}
+
+void TextureCache::clear() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_retained.clear();
+	m_retained_lookup.clear();
+	prune_expired();
+}
+
+void TextureCache::Releaser::operator()(const sf::Texture*) {
+	// Dropped first, the texture only counts as unreferenced without this reference
+	texture.reset();
+	TextureCache::get().on_release();
+}
+
+TextureHandle TextureCache::find(const std::string& path) {
+	const auto it = m_textures.find(path);
+	if (it != m_textures.end()) {
+		if (TextureHandle handle = it->second.lock()) {
+			retain(path, std::get_deleter<Releaser>(handle)->texture);
+			return handle;
+		}
+	}
+
+	// Unused but still retained, handed out again without reloading
+	const auto retained = m_retained_lookup.find(path);
+	if (retained == m_retained_lookup.end()) {
+		if (it != m_textures.end()) {
+			m_textures.erase(it);
+		}
+		return nullptr;
+	}
+	m_retained.splice(m_retained.begin(), m_retained, retained->second);
+	return share(path, retained->second->texture);
+}
+
+TextureHandle TextureCache::share(const std::string& path, const TextureHandle& texture) {
+	TextureHandle handle(texture.get(), Releaser{ texture });
+	m_textures[path] = handle;
+	return handle;
+}
+
+TextureHandle TextureCache::publish(const std::string& path, TextureHandle texture) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// Another thread loaded the same file meanwhile, share its texture
+	if (TextureHandle existing = find(path)) {
+		return existing;
+	}
+
+	if (m_textures.size() >= m_prune_threshold) {
+		prune_expired();
+	}
+	retain(path, texture);
+	return share(path, texture);
+}
+
+void TextureCache::retain(const std::string& path, const TextureHandle& texture) {
+	if (m_budget == 0) return;
+
+	const auto found = m_retained_lookup.find(path);
+	if (found != m_retained_lookup.end()) {
+		m_retained.splice(m_retained.begin(), m_retained, found->second);
+		return;
+	}
+
+	const sf::Vector2u size = texture->getSize();
+	const std::size_t bytes = static_cast<std::size_t>(size.x) * size.y * 4;
+
+	m_retained.push_front({ path, texture, bytes });
+	m_retained_lookup[path] = m_retained.begin();
+
+	trim();
+}
+
+void TextureCache::trim() {
+	// Only textures nothing but the cache references cost memory the budget could reclaim
+	std::size_t unreferenced_bytes = 0;
+	for (const auto& entry : m_retained) {
+		if (entry.texture.use_count() == 1) {
+			unreferenced_bytes += entry.bytes;
+		}
+	}
+
+	for (auto it = m_retained.end(); unreferenced_bytes > m_budget && it != m_retained.begin();) {
+		--it;
+		if (it->texture.use_count() != 1) continue;
+
+		unreferenced_bytes -= it->bytes;
+		m_retained_lookup.erase(it->path);
+		m_textures.erase(it->path);
+		it = m_retained.erase(it);
+	}
+}
+
+void TextureCache::on_release() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	trim();
+}
+
+void TextureCache::prune_expired() {
+	for (auto it = m_textures.begin(); it != m_textures.end();) {
+		if (it->second.expired()) {
+			it = m_textures.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+	m_prune_threshold = std::max<std::size_t>(64, m_textures.size() * 2);
+}
@@ -0,0 +1,78 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace thd
+{
+
+// Shared reference to a cached texture, the texture lives as long as any handle to it
+typedef std::shared_ptr<const sf::Texture> TextureHandle;
+
+// Process-wide path keyed texture cache, each file is decoded and uploaded once
+// no matter how many components display it
+class TextureCache {
+public:
+	static TextureCache& get();
+
+	// Returns the texture loaded from the path, loading it on first use, nullptr if it cannot be loaded
+	TextureHandle load(const std::string& path);
+	// Uploads an image decoded elsewhere under the path, returns the cached texture if one is alive
+	TextureHandle insert(const std::string& path, const sf::Image& image);
+
+	// Bytes of recently used textures the cache keeps alive after their last component releases them,
+	// least recently used textures are dropped first, 0 frees textures as soon as they are unused
+	// textures still referenced elsewhere do not count against the budget, it is enforced whenever
+	// a texture is released
+	void set_budget(std::size_t bytes);
+	std::size_t get_budget() const { return m_budget; }
+	// Bytes of textures kept alive only by the cache
+	std::size_t get_retained_bytes() const;
+
+	// Drops every reference held by the cache, textures still in use stay alive
+	void clear();
+private:
+	TextureCache() = default;
+
+	struct Retained {
+		std::string path;
+		TextureHandle texture;
+		std::size_t bytes;
+	};
+
+	// Deleter of the handles given out, lets the cache trim once the last of them is released
+	struct Releaser {
+		TextureHandle texture;
+		void operator()(const sf::Texture*);
+	};
+
+	// Returns the live texture of the path, dropping the entry if it expired
+	TextureHandle find(const std::string& path);
+	// Wraps the texture in a handle that reports its release, stored as the path's live handle
+	TextureHandle share(const std::string& path, const TextureHandle& texture);
+	// Stores a texture created outside the lock, unless another thread stored one for the path first
+	TextureHandle publish(const std::string& path, TextureHandle texture);
+	void retain(const std::string& path, const TextureHandle& texture);
+	void trim();
+	void on_release();
+	void prune_expired();
+
+	mutable std::mutex m_mutex;
+	// Handles given out per path, expired while no component uses the texture
+	std::unordered_map<std::string, std::weak_ptr<const sf::Texture>> m_textures;
+	// Size of m_textures at which expired entries are swept
+	std::size_t m_prune_threshold = 64;
+
+	// Most recently used first
+	std::list<Retained> m_retained;
+	std::unordered_map<std::string, std::list<Retained>::iterator> m_retained_lookup;
+	std::size_t m_budget = 0;
+};
+
+} // namespace thd
+#endif // TEXTURE_CACHE_HPP
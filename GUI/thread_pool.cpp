@@ -0,0 +1,51 @@
+#include "thread_pool.hpp"
+using namespace thd;
+
+ThreadPool::ThreadPool(unsigned thread_count) {
+	if (thread_count == 0) {
+		const unsigned hardware = std::thread::hardware_concurrency();
+		thread_count = hardware > 1 ? hardware - 1 : 1;
+	}
+
+	m_threads.reserve(thread_count);
+	for (unsigned i = 0; i < thread_count; ++i) {
+		m_threads.emplace_back(&ThreadPool::run, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+
+	for (auto& thread : m_threads) {
+		thread.join();
+	}
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(std::move(job));
+	}
+	m_condition.notify_one();
+}
+
+void ThreadPool::run() {
+	for (;;) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+
+			// Remaining jobs are drained before the workers exit
+			if (m_jobs.empty()) return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+		job();
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace thd
+{
+
+// Fixed set of worker threads running queued jobs in submission order
+class ThreadPool {
+public:
+	// 0 uses one thread less than the hardware provides, at least one
+	explicit ThreadPool(unsigned thread_count = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void submit(std::function<void()> job);
+	// Runs the task on a worker, its result or exception is delivered through the future
+	template <typename Task>
+	auto async(Task task) -> std::future<decltype(task())> {
+		auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(std::move(task));
+		std::future<decltype(task())> result = packaged->get_future();
+		submit([packaged] { (*packaged)(); });
+		return result;
+	}
+	std::size_t get_thread_count() const { return m_threads.size(); }
+private:
+	void run();
+
+	std::vector<std::thread> m_threads;
+	std::deque<std::function<void()>> m_jobs;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping = false;
+};
+
+} // namespace thd
+#endif // THREAD_POOL_HPP
@@ -6,25 +6,106 @@
 #include "../GUI/components/label.hpp"
 #include "../GUI/components/form/input_field.hpp"
 #include "../GUI/components/text_scroll.hpp"
+#include "../GUI/texture_atlas.hpp"
+#include "../GUI/asset_loader.hpp"
+#include "element_registry.hpp"
 
-#include <sstream>
+#include <cassert>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
 using namespace thd;
 
-Document::Document(const char* filename, const float& screen_size_x, const float& screen_size_y, const std::string& font_path) : m_filename(filename), m_root(nullptr), m_screen_size_x(screen_size_x), m_screen_size_y(screen_size_y){
-	m_document = std::make_unique<tinyxml2::XMLDocument>();
-	m_main_container = std::make_shared<Container>(AlignmentType::Vertical);
-	if (!m_font.loadFromFile(font_path)) {
+#ifndef NDEBUG
+// True if the tree is the only owner of every component below the container
+static bool owns_components(const Container& container) {
+	for (const auto& component : container.get_components()) {
+		if (component.use_count() != 1) return false;
+		if (const auto sub_container = std::dynamic_pointer_cast<Container>(component)) {
+			if (!owns_components(*sub_container)) return false;
+		}
+	}
+	return true;
+}
+#endif
+
+// Builds components straight from the parser's traversal, one element at a time, without an
+// intermediate LayoutNode tree
+class Document::Builder : public tinyxml2::XMLVisitor {
+public:
+	explicit Builder(Document& document) : m_document(document) {}
+
+	bool VisitEnter(const tinyxml2::XMLElement& element, const tinyxml2::XMLAttribute* first_attribute) override {
+		// The root element stands for the main container
+		if (m_parents.empty()) {
+			m_parents.push_back(m_document.m_main_container);
+			return true;
+		}
+
+		const auto& parent = m_parents.back();
+		LayoutNode node;
+		if (!parent || !parse_layout_attributes(&element, node)) {
+			m_parents.push_back(nullptr);
+			return false;
+		}
+
+		const auto component = m_document.create_component(node, parent);
+		if (!component || node.type != ElementType::Container) {
+			// Only containers have children worth visiting
+			m_parents.push_back(nullptr);
+			return false;
+		}
+
+		m_parents.push_back(std::static_pointer_cast<Container>(component));
+		return true;
+	}
+
+	bool VisitExit(const tinyxml2::XMLElement& element) override {
+		m_parents.pop_back();
+		return true;
+	}
+private:
+	Document& m_document;
+	std::vector<std::shared_ptr<Container>> m_parents;
+};
+
+Document::Document(const char* filename, const float& screen_size_x, const float& screen_size_y, const std::string& font_path) : m_filename(filename), m_screen_size_x(screen_size_x), m_screen_size_y(screen_size_y){
+	m_main_container = make_component<Container>(AlignmentType::Vertical);
+	m_main_container->set_index(&m_index);
+	m_main_container->set_screen_size(sf::Vector2f(m_screen_size_x, m_screen_size_y));
+	m_font = FontRegistry::get().load(font_path);
+	if (!m_font) {
 		std::cerr << "Error loading font file: " << font_path << std::endl;
+		m_font = std::make_shared<sf::Font>();
 	}
 }
 
+Document::~Document() {
+	// Pending asset callbacks hold weak references into the arena, they have to be released before it is
+	AssetLoader::get().cancel(this);
+
+	m_main_container->set_index(nullptr);
+	m_live.clear();
+	// A handle still held elsewhere would be freed into the arena after it is gone
+	assert(m_main_container.use_count() == 1 && owns_components(*m_main_container)
+		&& "Components of a Document must not outlive it");
+}
+
 void Document::load(const char* filename) {
-	if (m_document->LoadFile(filename) == tinyxml2::XML_SUCCESS) {
-		m_root = m_document->RootElement();
-		if (m_root) {
-			parse_components(m_root, m_main_container);
-			m_main_container->arrange_children();
+	// The parsed XML only lives until the components are built
+	tinyxml2::XMLDocument document;
+	if (document.LoadFile(filename) == tinyxml2::XML_SUCCESS) {
+		const tinyxml2::XMLElement* root = document.RootElement();
+		if (root) {
+			if (m_parallel_parsing) {
+				build_parallel(*root);
+			}
+			else {
+				Builder builder(*this);
+				root->Accept(&builder);
+			}
+			m_main_container->flush_layout();
 		}
 		else {
 			std::cerr << "Error: Root element not found in " << filename << std::endl;
@@ -35,306 +116,409 @@ void Document::load(const char* filename) {
 	}
 }
 
-AnchorPoint Document::parse_anchor_point(tinyxml2::XMLElement* element) {
-	const char* anchor_str = element->Attribute("anchorPoint");
-	if (!anchor_str) return AnchorPoint::TopLeft;
-
-	const std::string anchor(anchor_str);
-	if (anchor == "TopLeft") return AnchorPoint::TopLeft;
-	if (anchor == "TopCenter") return AnchorPoint::TopCenter;
-	if (anchor == "TopRight") return AnchorPoint::TopRight;
-	if (anchor == "CenterLeft") return AnchorPoint::CenterLeft;
-	if (anchor == "Center") return AnchorPoint::Center;
-	if (anchor == "CenterRight") return AnchorPoint::CenterRight;
-	if (anchor == "BottomLeft") return AnchorPoint::BottomLeft;
-	if (anchor == "BottomCenter") return AnchorPoint::BottomCenter;
-	if (anchor == "BottomRight") return AnchorPoint::BottomRight;
-
-	return AnchorPoint::TopLeft;
-}
+void Document::build_parallel(const tinyxml2::XMLElement& root) {
+	ThreadPool& pool = AssetLoader::get().get_pool();
+
+	// Pages usually wrap everything in one top level container, splitting there would leave a single
+	// task, so containers with a single child are created here until the tree branches
+	std::shared_ptr<Container> parent = m_main_container;
+	const tinyxml2::XMLElement* level = &root;
+	while (level->FirstChildElement() && !level->FirstChildElement()->NextSiblingElement()) {
+		const tinyxml2::XMLElement* only_child = level->FirstChildElement();
+
+		LayoutNode node;
+		if (!parse_layout_attributes(only_child, node)) return;
+
+		const auto component = create_component(node, parent);
+		if (!component || node.type != ElementType::Container) return;
 
-void Document::parse_components(tinyxml2::XMLElement* element, std::shared_ptr<Container> parent_container) {
-	sf::Vector2f parent_size = parent_container->get_size();
+		parent = std::static_pointer_cast<Container>(component);
+		level = only_child;
+	}
 
-	for (tinyxml2::XMLElement* child = element->FirstChildElement();
+	// tinyxml2 decodes strings lazily on first read, which is safe here because every worker
+	// touches a disjoint subtree and this thread only walks the sibling links
+	std::vector<std::future<std::optional<LayoutNode>>> subtrees;
+	for (const tinyxml2::XMLElement* child = level->FirstChildElement();
 		child != nullptr;
 		child = child->NextSiblingElement()) {
 
-		if (child->ToComment()) continue;
-
-		const std::string tag = child->Value();
-		auto component = create_element(tag, child, parent_container, parent_size);
+		subtrees.push_back(pool.async([child] {
+			LayoutNode node;
+			if (!parse_layout_node(child, node)) return std::optional<LayoutNode>();
+			return std::optional<LayoutNode>(std::move(node));
+		}));
+	}
 
-		if (component) {
-			component->set_position(parse_position(child));
-			component->set_anchor_point(parse_anchor_point(child));
+	// Fonts and textures belong to this thread's GL context, so components are created here
+	// attaching each subtree as soon as it and every subtree before it are parsed
+	for (auto& subtree : subtrees) {
+		const std::optional<LayoutNode> node = subtree.get();
+		if (node) {
+			create_element(*node, parent);
 		}
 	}
 }
 
-std::shared_ptr<Component> Document::create_element(const std::string& tag,
-	tinyxml2::XMLElement* element,
-	std::shared_ptr<Container> parent_container,
-	const sf::Vector2f& parent_size) {
+bool Document::watch(const std::string& filename) {
+	m_main_container->clear_components();
+	m_live.clear();
+	m_watch_path = filename;
+	return reload();
+}
 
-	if (tag == "button") {
-		sf::Vector2f position = parse_position(element);
-		sf::Vector2f size = parse_size(element, parent_size);
-		sf::Color color = parse_color(element, "color");
-		sf::Color hover_color = parse_color(element, "hoverColor");
-		sf::Color click_color = parse_color(element, "clickColor");
+bool Document::poll_changes() {
+	// Checking the file system every frame would be wasteful
+	if (m_watch_path.empty() || m_watch_clock.getElapsedTime().asSeconds() < 0.25f) return false;
+	m_watch_clock.restart();
 
-		const char* label_text = element->Attribute("label");
-		if (!label_text) label_text = "Button";
+	std::error_code error;
+	const auto write_time = std::filesystem::last_write_time(m_watch_path, error);
+	if (error || write_time == m_watch_time) return false;
 
-		const unsigned font_size = static_cast<unsigned>(element->IntAttribute("fontSize", 24));
+	return reload();
+}
 
-		auto button = std::make_shared<Button>(
-			label_text,
-			position,
-			size,
-			color,
-			hover_color,
-			click_color,
-			label_text,
-			m_font,
-			font_size,
-			[]() { std::cout << "Button clicked" << std::endl; }
-		);
+bool Document::reload() {
+	std::error_code error;
+	m_watch_time = std::filesystem::last_write_time(m_watch_path, error);
+
+	tinyxml2::XMLDocument document;
+	if (document.LoadFile(m_watch_path.c_str()) != tinyxml2::XML_SUCCESS) {
+		// A half-saved file keeps the current tree until the next change
+		std::cerr << "Error loading file: " << m_watch_path << std::endl;
+		return false;
+	}
 
-		if (parent_container) {
-			parent_container->add_component(button);
+	const tinyxml2::XMLElement* root = document.RootElement();
+	if (!root) {
+		std::cerr << "Error: Root element not found in " << m_watch_path << std::endl;
+		return false;
+	}
+
+	std::vector<LayoutNode> nodes;
+	for (const tinyxml2::XMLElement* child = root->FirstChildElement();
+		child != nullptr;
+		child = child->NextSiblingElement()) {
+
+		LayoutNode node;
+		if (parse_layout_node(child, node)) {
+			nodes.push_back(std::move(node));
 		}
-		return button;
 	}
-	else if (tag == "container") {
-		const char* alignment_str = element->Attribute("alignment");
-		AlignmentType alignment = AlignmentType::Vertical;
-		const char* fit_str = element->Attribute("fit");
-		FitType fit = FitType::Default;
-		sf::Color bg_color = parse_color(element, "color");
-
-		if (alignment_str) {
-			std::string align_str(alignment_str);
-			alignment = (align_str == "horizontal") ? AlignmentType::Horizontal : AlignmentType::Vertical;
+
+	patch(m_main_container, m_live, nodes);
+	m_main_container->flush_layout();
+	return true;
+}
+
+void Document::patch(const std::shared_ptr<Container>& container, std::vector<LiveNode>& live, std::vector<LayoutNode>& nodes) {
+	std::vector<bool> matched(live.size(), false);
+	std::vector<LiveNode> patched;
+	patched.reserve(nodes.size());
+
+	for (auto& node : nodes) {
+		// Pairs the node with the first unmatched live node of the same kind and identifier,
+		// so repeated identifiers keep their document order
+		LiveNode* previous = nullptr;
+		for (std::size_t i = 0; i < live.size(); ++i) {
+			if (!matched[i] && live[i].node.type == node.type && live[i].node.tag == node.tag && live[i].node.id == node.id) {
+				matched[i] = true;
+				previous = &live[i];
+				break;
+			}
 		}
 
-		if (fit_str) {
-			std::string fit_str_temp(fit_str);
-			fit = (fit_str_temp == "fit") ? FitType::Fit : FitType::Default;
+		std::vector<LayoutNode> children = std::move(node.children);
+		node.children.clear();
+
+		LiveNode entry;
+		if (previous && same_attributes(previous->node, node, true)) {
+			entry.component = previous->component;
+			if (!same_attributes(previous->node, node)) {
+				entry.component->set_anchor_point(node.anchor_point);
+				entry.component->set_position(node.position);
+			}
+			// Handed over from a replaced container, size it as if it had been built under the new one,
+			// the layout pass then resolves its relative sizes against the new parent
+			if (entry.component->get_parent() != container.get()) {
+				apply_sizing(node, *entry.component, container.get());
+			}
 		}
+		else {
+			entry.component = create_component(node, container);
+			if (!entry.component) continue;
+		}
+		entry.node = std::move(node);
 
-		auto container = std::make_shared<Container>(
-			alignment,
-			fit,
-			parse_position(element),
-			parse_size(element, parent_size),
-			bg_color
-		);
+		if (entry.node.type == ElementType::Container) {
+			std::vector<LiveNode> previous_children;
+			if (previous) {
+				previous_children = std::move(previous->children);
 
-		parse_components(element, container);
+				// A replaced container hands its children over to the new one
+				if (previous->component != entry.component) {
+					std::static_pointer_cast<Container>(previous->component)->clear_components();
+				}
+			}
 
-		if (parent_container) {
-			parent_container->add_component(container);
+			patch(std::static_pointer_cast<Container>(entry.component), previous_children, children);
+			entry.children = std::move(previous_children);
 		}
 
-		container->arrange_children();
+		patched.push_back(std::move(entry));
+	}
 
-		return container;
+	// Reattach in document order only if components were added, removed, replaced or reordered
+	const auto& current = container->get_components();
+	bool same_order = current.size() == patched.size();
+	if (same_order) {
+		auto it = current.begin();
+		for (const auto& entry : patched) {
+			if (*it++ != entry.component) {
+				same_order = false;
+				break;
+			}
+		}
 	}
-	else if (tag == "image") {
-		const char* image_path = element->Attribute("path");
-		if (!image_path) return nullptr;
 
-		const char* identifier = element->Attribute("id");
-		if (!identifier) identifier = "image";
+	if (!same_order) {
+		container->clear_components();
+		for (const auto& entry : patched) {
+			container->add_component(entry.component);
+		}
+	}
 
-		const int width = element->IntAttribute("width", 64);
-		const int height = element->IntAttribute("height", 64);
+	live = std::move(patched);
+}
 
-		auto image = std::make_shared<Image>(
-			identifier,
-			image_path,
-			width,
-			height
-		);
+bool Document::load_compiled(const char* filename) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open()) {
+		std::cerr << "Error loading file: " << filename << std::endl;
+		return false;
+	}
 
-		if (parent_container) {
-			parent_container->add_component(image);
-		}
-		return image;
+	const std::vector<char> blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::vector<LayoutNode> nodes;
+	if (!read_compiled_layout(blob.data(), blob.size(), nodes)) {
+		std::cerr << "Error: " << filename << " is not a compiled layout" << std::endl;
+		return false;
 	}
-	else if (tag == "label") {
-		const char* text = element->Attribute("text");
-		if (!text) text = "Label";
-
-		const char* identifier = element->Attribute("id");
-		if (!identifier) identifier = "label";
-
-		const unsigned font_size = static_cast<unsigned>(element->IntAttribute("fontSize", 24));
-		sf::Color color = parse_color(element, "color");
-
-		auto label = std::make_shared<Label>(
-			identifier,
-			m_font,
-			text,
-			font_size,
-			color
-		);
 
-		const AnchorPoint anchor_point = parse_anchor_point(element);
-		label->set_anchor_point(anchor_point);
+	for (const auto& node : nodes) {
+		create_element(node, m_main_container);
+	}
+	m_main_container->flush_layout();
+	return true;
+}
 
-		if (parent_container) {
-			parent_container->add_component(label);
+std::shared_ptr<Component> Document::create_element(const LayoutNode& node, std::shared_ptr<Container> parent_container) {
+	auto component = create_component(node, parent_container);
+
+	if (component && node.type == ElementType::Container) {
+		const auto container = std::static_pointer_cast<Container>(component);
+		for (const auto& child : node.children) {
+			create_element(child, container);
 		}
-		return label;
 	}
-	else if (tag == "inputField") {
-		const char* identifier = element->Attribute("id");
-		if (!identifier) identifier = "inputField";
-
-		const sf::Vector2f position = parse_position(element);
-		const sf::Vector2f size = parse_size(element, parent_size);
-		const unsigned font_size = static_cast<unsigned>(element->IntAttribute("fontSize", 24));
-		const sf::Color color = parse_color(element, "color");
-		const sf::Color text_color = parse_color(element, "textColor");
-		const sf::Color cursor_color = parse_color(element, "cursorColor");
-		const std::string placeholder_text = element->Attribute("placeholderText") ? element->Attribute("placeholderText") : "";
-		const std::string initial_text = element->Attribute("text") ? element->Attribute("text") : "";
-
-		auto input_field = std::make_shared<InputField>(
-			identifier,
-			position,
-			size,
-			m_font,
-			font_size,
-			color,
-			text_color,
-			cursor_color,
-			placeholder_text,
-			initial_text,
+	return component;
+}
+
+std::shared_ptr<Component> Document::create_component(const LayoutNode& node, std::shared_ptr<Container> parent_container) {
+	const sf::Vector2f parent_size = parent_container ? parent_container->get_size() : sf::Vector2f(0.0f, 0.0f);
+	std::shared_ptr<Component> component;
+
+	switch (node.type) {
+	case ElementType::Button: {
+		component = make_component<Button>(
+			node.id,
+			node.position,
+			resolve_size(node, parent_size),
+			node.color,
+			node.hover_color,
+			node.click_color,
+			node.text,
+			*m_font,
+			node.font_size,
+			[]() { std::cout << "Button clicked" << std::endl; }
+		);
+		break;
+	}
+	case ElementType::Container: {
+		auto container = make_component<Container>(
+			node.alignment,
+			node.fit,
+			node.position,
+			resolve_size(node, parent_size),
+			node.color
+		);
+		container->set_cached(node.cached);
+		container->set_gap(node.gap);
+		container->set_padding(node.padding);
+		component = container;
+		break;
+	}
+	case ElementType::Image: {
+		const int width = node.width.unit == SizeUnit::Pixels ? static_cast<int>(node.width.value) : 64;
+		const int height = node.height.unit == SizeUnit::Pixels ? static_cast<int>(node.height.value) : 64;
+
+		AtlasRegion region;
+		if (TextureAtlas::get().find(node.path, region)) {
+			component = make_component<Image>(
+				node.id,
+				node.path,
+				width,
+				height
+			);
+			break;
+		}
+
+		// Shows a placeholder while the file is decoded on a worker
+		auto image = make_component<Image>(node.id, width, height);
+		const std::weak_ptr<Image> weak_image = image;
+		const std::string path = node.path;
+		AssetLoader::get().request_image(path, [weak_image, path](const sf::Image* decoded) {
+			auto target = weak_image.lock();
+			if (!target) return;
+
+			if (!decoded || !target->set_image(path, *decoded)) {
+				std::cerr << "Failed to load image: " << path << std::endl;
+			}
+		}, this);
+		component = image;
+		break;
+	}
+	case ElementType::Label: {
+		component = make_component<Label>(
+			node.id,
+			*m_font,
+			node.text,
+			node.font_size,
+			node.color
+		);
+		break;
+	}
+	case ElementType::InputField: {
+		component = make_component<InputField>(
+			node.id,
+			node.position,
+			resolve_size(node, parent_size),
+			*m_font,
+			node.font_size,
+			node.color,
+			node.text_color,
+			node.cursor_color,
+			node.placeholder_text,
+			node.text,
 			m_screen_size_x,
 			m_screen_size_y
 		);
-
-		if (parent_container) {
-			parent_container->add_component(input_field);
-		}
-		return input_field;
+		break;
 	}
-	else if (tag == "textScroll") {
-		const char* identifier = element->Attribute("id");
-		if (!identifier) identifier = "textScroll";
-
-		const sf::Vector2f position = parse_position(element);
-		sf::Vector2f size;
-
+	case ElementType::TextScroll: {
+		// Fit containers assign the size once the layout is flushed
 		const bool is_fit_container = parent_container && parent_container->get_fit_type() == FitType::Fit;
+		const sf::Vector2f size = is_fit_container ? sf::Vector2f(0, 0) : resolve_size(node, parent_size);
 
-		if (!is_fit_container) {
-			size = parse_size(element, parent_size);
-		}
-		else {
-			size = sf::Vector2f(0, 0);
-		}
-
-		const unsigned font_size = static_cast<unsigned>(element->IntAttribute("fontSize", 24));
-		const sf::Color background_color = parse_color(element, "color");
-		const sf::Color font_color = parse_color(element, "textColor");
-		const std::string initial_text = element->Attribute("text") ? element->Attribute("text") : "";
-		const std::string path = element->Attribute("path") ? element->Attribute("path") : "none";
-
-		auto text_scroll = std::make_shared<TextScroll>(
-			identifier,
-			initial_text,
-			m_font,
-			position,
+		component = make_component<TextScroll>(
+			node.id,
+			node.text,
+			*m_font,
+			node.position,
 			size,
-			background_color,
-			font_color,
-			font_size,
+			node.color,
+			node.text_color,
+			node.font_size,
 			m_screen_size_x,
 			m_screen_size_y,
-			path,
+			"none",
 			is_fit_container
 		);
 
-		if (parent_container) {
-			parent_container->add_component(text_scroll);
+		// The file is opened on a worker, the scroll shows the inline text until it arrives
+		if (!node.path.empty()) {
+			const std::weak_ptr<TextScroll> weak_scroll = std::static_pointer_cast<TextScroll>(component);
+			const std::string path = node.path;
+			AssetLoader::get().request_text(path, [weak_scroll, path](TextSource* source) {
+				auto target = weak_scroll.lock();
+				if (!target) return;
+
+				if (!source) {
+					std::cerr << "Error: Could not open file " << path << std::endl;
+					return;
+				}
+				target->set_source(std::move(*source));
+			}, this);
 		}
-
-		return text_scroll;
+		break;
+	}
+	case ElementType::Custom: {
+		const ElementFactory* factory = ElementRegistry::get().find(node.tag);
+		if (factory) {
+			component = (*factory)(node, ElementContext{ *m_font, resolve_size(node, parent_size), m_screen_size_x, m_screen_size_y });
 		}
+		if (!component) {
+			std::cerr << "Error: No component created for <" << node.tag << ">" << std::endl;
+			return nullptr;
+		}
+		break;
+	}
+	}
 
-	return nullptr;
-}
-
-sf::Vector2f Document::parse_position(tinyxml2::XMLElement* element) {
-	float x = 0.0f, y = 0.0f;
-	element->QueryFloatAttribute("x", &x);
-	element->QueryFloatAttribute("y", &y);
-	return sf::Vector2f(x, y);
-}
-
-sf::Vector2f Document::parse_size(tinyxml2::XMLElement* element, const sf::Vector2f& parent_size) {
-	float width = 100.0f, height = 50.0f;
-	const char* width_attr = element->Attribute("width");
-	const char* height_attr = element->Attribute("height");
+	apply_sizing(node, *component, parent_container.get());
 
-	if (width_attr) {
-		const std::string width_str(width_attr);
-		if (width_str == "SCREEN_SIZE_X") {
-			width = m_screen_size_x;
-		}
-		else if (width_str.back() == '%') {
-			const float percent = std::stof(width_str.substr(0, width_str.size() - 1));
-			width = (percent / 100.0f) * parent_size.x;
-		}
-		else {
-			width = std::stof(width_str);
-		}
+	component->set_anchor_point(node.anchor_point);
+	if (parent_container) {
+		parent_container->add_component(component);
 	}
+	component->set_position(node.position);
 
-	if (height_attr) {
-		const std::string height_str(height_attr);
-		if (height_str == "SCREEN_SIZE_Y") {
-			height = m_screen_size_y;
-		}
-		else if (height_str.back() == '%') {
-			const float percent = std::stof(height_str.substr(0, height_str.size() - 1));
-			height = (percent / 100.0f) * parent_size.y;
-		}
-		else {
-			height = std::stof(height_str);
+	return component;
+}
+
+void Document::apply_sizing(const LayoutNode& node, Component& component, const Container* parent_container) {
+	FlexItem flex = node.flex;
+	if (flex.basis < 0.0f && parent_container && parent_container->get_fit_type() == FitType::Flex) {
+		// The solver derives the basis from the main size written in the page, without one the built
+		// size is the basis, so later passes grow and shrink from it rather than from their own result
+		const bool vertical = parent_container->get_alignment_type() == AlignmentType::Vertical;
+		if ((vertical ? node.height : node.width).unit == SizeUnit::Unset) {
+			const sf::Vector2f size = component.get_size();
+			flex.basis = vertical ? size.y : size.x;
 		}
 	}
-
-	return sf::Vector2f(width, height);
+	component.set_flex(flex);
+	component.set_size_expression(node.width, node.height);
 }
 
-sf::Color Document::parse_color(tinyxml2::XMLElement* element, const std::string& attr_name) {
-	const char* color_str = element->Attribute(attr_name.c_str());
-	if (!color_str) return sf::Color::White;
+sf::Vector2f Document::resolve_size(const LayoutNode& node, const sf::Vector2f& parent_size) const {
+	return sf::Vector2f(
+		node.width.resolve(parent_size.x, m_screen_size_x, m_screen_size_y, 100.0f),
+		node.height.resolve(parent_size.y, m_screen_size_x, m_screen_size_y, 50.0f)
+	);
+}
 
-	int r = 255, g = 255, b = 255, a = 255;
-	std::istringstream color_stream(color_str);
-	char separator;
+void Document::resize(const sf::Vector2f& screen_size) {
+	if (screen_size.x <= 0.0f || screen_size.y <= 0.0f) return;
+	if (screen_size.x == m_screen_size_x && screen_size.y == m_screen_size_y) return;
 
-	if (!(color_stream >> r >> separator >> g >> separator >> b)) {
-		return sf::Color::White;
-	}
+	m_screen_size_x = screen_size.x;
+	m_screen_size_y = screen_size.y;
 
-	if (color_stream >> separator >> a) {}
+	if (!m_main_container) return;
 
-	return sf::Color(
-		static_cast<uint8_t>(r),
-		static_cast<uint8_t>(g),
-		static_cast<uint8_t>(b),
-		static_cast<uint8_t>(a)
-	);
+	// Every container's layout is invalidated, the pass re-resolves relative sizes top-down
+	// so each one sees its parent's new size
+	m_main_container->set_screen_size(screen_size);
+	m_main_container->flush_layout();
+	m_main_container->invalidate_render(Component::FULL_DAMAGE);
 }
 
 const std::shared_ptr<Container> Document::get_main_container() const {
 	return m_main_container;
+}
+
+std::shared_ptr<Component> Document::find_component(const std::string& identifier) const {
+	return m_index.find(identifier);
 }
\ No newline at end of file
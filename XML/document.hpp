@@ -2,37 +2,86 @@
 #define DOCUMENT_HPP
 
 #include "../GUI/container.hpp"
+#include "../GUI/component_index.hpp"
+#include "../GUI/font_registry.hpp"
+#include "layout_node.hpp"
 #include "tinyxml2.h"
+#include <filesystem>
+#include <memory_resource>
 
 namespace thd
 {
 
+// Owns the component tree of a page, the components are allocated from the document's arena.
+// The shared pointers it hands out are only valid while the document lives, every copy (and any
+// weak_ptr to a component) has to be released before the document is destroyed
 class Document {
 public:
 	Document(const char* filename, const float& screen_size_x, const float& screen_size_y, const std::string& font_path);
+	~Document();
 
 	void load(const char* filename);
+	// Parses the sibling subtrees at the first level where the page branches concurrently on the
+	// AssetLoader's workers, the components are still created on the calling thread in document order
+	void set_parallel_parsing(bool parallel) { m_parallel_parsing = parallel; }
+	// Builds the page from the file and keeps following it, replacing whatever load() built
+	bool watch(const std::string& filename);
+	// Re-applies the watched file if it changed on disk, returns true if the tree was patched
+	// unchanged components are kept together with their state
+	bool poll_changes();
+	bool is_watching() const { return !m_watch_path.empty(); }
+	// Builds the tree from a layout blob produced by ThornedLayoutCompiler
+	bool load_compiled(const char* filename);
+	// Re-resolves percentage and screen relative sizes against the new screen size and re-runs
+	// the layout, the tree and the state of its components are kept
+	void resize(const sf::Vector2f& screen_size);
+	// Both handles point into the document's arena and must not outlive the document
 	const std::shared_ptr<Container> get_main_container() const;
+	// Finds a component anywhere in the tree by identifier
+	std::shared_ptr<Component> find_component(const std::string& identifier) const;
 private:
-	void parse_components(tinyxml2::XMLElement* element, std::shared_ptr<Container> parent_container);
+	class Builder;
 
-	std::shared_ptr<Component> create_element(const std::string& tag,
-		tinyxml2::XMLElement* element,
-		std::shared_ptr<Container> parent_container,
-		const sf::Vector2f& parent_size);
+	// A component built from the watched file together with the node it was built from
+	struct LiveNode {
+		LayoutNode node;
+		std::shared_ptr<Component> component;
+		std::vector<LiveNode> children;
+	};
 
-	sf::Vector2f parse_position(tinyxml2::XMLElement* element);
-	sf::Vector2f parse_size(tinyxml2::XMLElement* element, const sf::Vector2f& parent_size);
-	sf::Color parse_color(tinyxml2::XMLElement* element, const std::string& attribute_name);
-	AnchorPoint parse_anchor_point(tinyxml2::XMLElement* element);
+	// Allocates the component together with its reference count from the arena
+	template <typename T, typename... Args>
+	std::shared_ptr<T> make_component(Args&&... args) {
+		return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(&m_arena), std::forward<Args>(args)...);
+	}
+
+	void build_parallel(const tinyxml2::XMLElement& root);
+	bool reload();
+	// Brings the children of the container in line with the nodes, reusing matching live components
+	void patch(const std::shared_ptr<Container>& container, std::vector<LiveNode>& live, std::vector<LayoutNode>& nodes);
+
+	// Creates the component of the node together with its subtree
+	std::shared_ptr<Component> create_element(const LayoutNode& node, std::shared_ptr<Container> parent_container);
+	// Creates only the node's own component and adds it to the parent
+	std::shared_ptr<Component> create_component(const LayoutNode& node, std::shared_ptr<Container> parent_container);
+	// Stores the node's size expressions and flex item on the component
+	void apply_sizing(const LayoutNode& node, Component& component, const Container* parent_container);
+	sf::Vector2f resolve_size(const LayoutNode& node, const sf::Vector2f& parent_size) const;
 private:
+	// Declared first so it is released last, after everything referencing the components
+	// components are only created on the main thread, so it needs no locking
+	std::pmr::unsynchronized_pool_resource m_arena;
 	float m_screen_size_x, m_screen_size_y;
-	std::unique_ptr<tinyxml2::XMLDocument> m_document;
-	tinyxml2::XMLElement* m_root;
+	ComponentIndex m_index;
 	std::shared_ptr<Container> m_main_container;
-	sf::Font m_font;
+	FontHandle m_font;
 	const char* m_filename;
+	bool m_parallel_parsing = false;
+	std::string m_watch_path;
+	std::filesystem::file_time_type m_watch_time;
+	sf::Clock m_watch_clock;
+	std::vector<LiveNode> m_live;
 };
 
 } // namespace thd
-#endif // DOCUMENT_HPP
\ No newline at end of file
+#endif // DOCUMENT_HPP
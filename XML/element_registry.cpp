@@ -0,0 +1,16 @@
+#include "element_registry.hpp"
+using namespace thd;
+
+ElementRegistry& ElementRegistry::get() {
+	static ElementRegistry registry;
+	return registry;
+}
+
+void ElementRegistry::register_element(const std::string& tag, ElementFactory factory) {
+	m_factories[tag] = std::move(factory);
+}
+
+const ElementFactory* ElementRegistry::find(const std::string& tag) const {
+	const auto it = m_factories.find(tag);
+	return it != m_factories.end() ? &it->second : nullptr;
+}
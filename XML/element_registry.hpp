@@ -0,0 +1,41 @@
+#ifndef ELEMENT_REGISTRY_HPP
+#define ELEMENT_REGISTRY_HPP
+
+#include "layout_node.hpp"
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace thd
+{
+
+// What a custom element factory gets to know about the document building it
+struct ElementContext {
+	const sf::Font& font;
+	// Size resolved from the width and height attributes against the parent
+	sf::Vector2f size;
+	float screen_size_x;
+	float screen_size_y;
+};
+
+typedef std::function<std::shared_ptr<Component>(const LayoutNode& node, const ElementContext& context)> ElementFactory;
+
+// Factories for page tags beyond the built-in ones, registered tags are parsed into
+// ElementType::Custom nodes with the common attributes filled in
+class ElementRegistry {
+public:
+	static ElementRegistry& get();
+
+	// Built-in tags always take precedence over registered ones
+	void register_element(const std::string& tag, ElementFactory factory);
+	bool contains(const std::string& tag) const { return m_factories.count(tag) != 0; }
+	// nullptr if the tag was never registered
+	const ElementFactory* find(const std::string& tag) const;
+private:
+	ElementRegistry() = default;
+
+	std::unordered_map<std::string, ElementFactory> m_factories;
+};
+
+} // namespace thd
+#endif // ELEMENT_REGISTRY_HPP
@@ -0,0 +1,509 @@
+#include "layout_node.hpp"
+#include "element_registry.hpp"
+#include "perfect_hash.hpp"
+#include <charconv>
+#include <cstring>
+#include <string_view>
+using namespace thd;
+
+namespace
+{
+
+const char COMPILED_LAYOUT_MAGIC[4] = { 'T', 'H', 'D', 'L' };
+const unsigned COMPILED_LAYOUT_VERSION = 4;
+
+// In ElementType order
+constexpr PerfectHash<6, 16> ELEMENT_TAGS(std::array<std::string_view, 6>{ {
+	"button", "container", "image", "label", "inputField", "textScroll"
+} });
+
+// In AnchorPoint order
+constexpr PerfectHash<9, 16> ANCHOR_NAMES(std::array<std::string_view, 9>{ {
+	"TopLeft", "TopCenter", "TopRight",
+	"CenterLeft", "Center", "CenterRight",
+	"BottomLeft", "BottomCenter", "BottomRight"
+} });
+
+enum class Attribute : unsigned char {
+	X,
+	Y,
+	Width,
+	Height,
+	AnchorPoint,
+	FontSize,
+	Color,
+	Label,
+	HoverColor,
+	ClickColor,
+	Alignment,
+	Fit,
+	Cache,
+	Id,
+	Path,
+	Text,
+	PlaceholderText,
+	TextColor,
+	CursorColor,
+	Gap,
+	Padding,
+	Grow,
+	Shrink,
+	Basis,
+	MinSize,
+	MaxSize
+};
+
+const std::size_t ATTRIBUTE_COUNT = static_cast<std::size_t>(Attribute::MaxSize) + 1;
+
+// In Attribute order
+constexpr PerfectHash<ATTRIBUTE_COUNT, 128> ATTRIBUTE_NAMES(std::array<std::string_view, ATTRIBUTE_COUNT>{ {
+	"x", "y", "width", "height", "anchorPoint", "fontSize", "color", "label", "hoverColor", "clickColor",
+	"alignment", "fit", "cache", "id", "path", "text", "placeholderText", "textColor", "cursorColor",
+	"gap", "padding", "grow", "shrink", "basis", "minSize", "maxSize"
+} });
+
+// Values of the known attributes of one element, nullptr where absent
+class AttributeValues {
+public:
+	// Reads every attribute of the element in a single pass, unknown ones are ignored
+	explicit AttributeValues(const tinyxml2::XMLElement* element) {
+		for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute();
+			attribute != nullptr;
+			attribute = attribute->Next()) {
+
+			const int index = ATTRIBUTE_NAMES.find(attribute->Name());
+			if (index >= 0) {
+				m_values[index] = attribute->Value();
+			}
+		}
+	}
+
+	const char* operator[](Attribute attribute) const { return m_values[static_cast<std::size_t>(attribute)]; }
+private:
+	const char* m_values[ATTRIBUTE_COUNT] = {};
+};
+
+static_assert(ELEMENT_TAGS.find("textScroll") == static_cast<int>(ElementType::TextScroll), "Tag table out of order");
+static_assert(ANCHOR_NAMES.find("BottomRight") == AnchorPoint::BottomRight, "Anchor table out of order");
+static_assert(ATTRIBUTE_NAMES.find("maxSize") == static_cast<int>(Attribute::MaxSize), "Attribute table out of order");
+
+bool parse_element_type(const char* tag, ElementType& type) {
+	const int index = ELEMENT_TAGS.find(tag);
+	if (index < 0) return false;
+
+	type = static_cast<ElementType>(index);
+	return true;
+}
+
+AnchorPoint parse_anchor_point(const char* anchor) {
+	if (!anchor) return AnchorPoint::TopLeft;
+
+	const int index = ANCHOR_NAMES.find(anchor);
+	return index < 0 ? AnchorPoint::TopLeft : static_cast<AnchorPoint>(index);
+}
+
+const char* skip_spaces(const char* it, const char* end) {
+	while (it != end && (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r')) ++it;
+	return it;
+}
+
+// Reads the number at the start of [it, end), returns the position past it or nullptr if there is none
+template <typename T>
+const char* scan_number(const char* it, const char* end, T& value) {
+	it = skip_spaces(it, end);
+	if (it != end && *it == '+') ++it;
+
+	const std::from_chars_result result = std::from_chars(it, end, value);
+	return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+// Leaves the value untouched if the attribute is absent or unreadable
+void parse_float(const char* text, float& value) {
+	if (!text) return;
+
+	float parsed = 0.0f;
+	if (scan_number(text, text + std::strlen(text), parsed)) value = parsed;
+}
+
+FitType parse_fit(const char* fit) {
+	if (!fit) return FitType::Default;
+
+	const std::string_view value(fit);
+	if (value == "fit") return FitType::Fit;
+	if (value == "flex") return FitType::Flex;
+	return FitType::Default;
+}
+
+std::string parse_string(const char* value, const char* fallback) {
+	return value ? value : fallback;
+}
+
+class LayoutWriter {
+public:
+	explicit LayoutWriter(std::vector<char>& output) : m_output(output) {}
+
+	template <typename T>
+	void write(const T& value) {
+		const char* bytes = reinterpret_cast<const char*>(&value);
+		m_output.insert(m_output.end(), bytes, bytes + sizeof(T));
+	}
+
+	void write_string(const std::string& value) {
+		write(static_cast<unsigned>(value.size()));
+		m_output.insert(m_output.end(), value.begin(), value.end());
+	}
+
+	void write_color(const sf::Color& color) {
+		write(color.r);
+		write(color.g);
+		write(color.b);
+		write(color.a);
+	}
+
+	void write_size(const SizeValue& size) {
+		write(static_cast<unsigned char>(size.unit));
+		write(size.value);
+	}
+
+	void write_node(const LayoutNode& node) {
+		write(static_cast<unsigned char>(node.type));
+		write(static_cast<unsigned char>(node.anchor_point));
+		write(static_cast<unsigned char>(node.alignment));
+		write(static_cast<unsigned char>(node.fit));
+		write(static_cast<unsigned char>(node.cached));
+		write(node.position.x);
+		write(node.position.y);
+		write_size(node.width);
+		write_size(node.height);
+		write_color(node.color);
+		write_color(node.hover_color);
+		write_color(node.click_color);
+		write_color(node.text_color);
+		write_color(node.cursor_color);
+		write(node.font_size);
+		write(node.gap);
+		write(node.padding);
+		write(node.flex.grow);
+		write(node.flex.shrink);
+		write(node.flex.basis);
+		write(node.flex.min_size);
+		write(node.flex.max_size);
+		write_string(node.id);
+		write_string(node.text);
+		write_string(node.placeholder_text);
+		write_string(node.path);
+		write_string(node.tag);
+
+		write(static_cast<unsigned>(node.children.size()));
+		for (const auto& child : node.children) {
+			write_node(child);
+		}
+	}
+private:
+	std::vector<char>& m_output;
+};
+
+class LayoutReader {
+public:
+	LayoutReader(const char* data, std::size_t size) : m_data(data), m_end(data + size) {}
+
+	template <typename T>
+	bool read(T& value) {
+		if (static_cast<std::size_t>(m_end - m_data) < sizeof(T)) return false;
+		std::memcpy(&value, m_data, sizeof(T));
+		m_data += sizeof(T);
+		return true;
+	}
+
+	template <typename E>
+	bool read_enum(E& value, unsigned char count) {
+		unsigned char raw = 0;
+		if (!read(raw) || raw >= count) return false;
+		value = static_cast<E>(raw);
+		return true;
+	}
+
+	bool read_string(std::string& value) {
+		unsigned length = 0;
+		if (!read(length) || static_cast<std::size_t>(m_end - m_data) < length) return false;
+		value.assign(m_data, length);
+		m_data += length;
+		return true;
+	}
+
+	bool read_color(sf::Color& color) {
+		return read(color.r) && read(color.g) && read(color.b) && read(color.a);
+	}
+
+	bool read_size(SizeValue& size) {
+		return read_enum(size.unit, 5) && read(size.value);
+	}
+
+	bool read_node(LayoutNode& node) {
+		unsigned child_count = 0;
+		unsigned char cached = 0;
+		const bool valid = read_enum(node.type, 7)
+			&& read_enum(node.anchor_point, 9)
+			&& read_enum(node.alignment, 2)
+			&& read_enum(node.fit, 3)
+			&& read(cached)
+			&& read(node.position.x)
+			&& read(node.position.y)
+			&& read_size(node.width)
+			&& read_size(node.height)
+			&& read_color(node.color)
+			&& read_color(node.hover_color)
+			&& read_color(node.click_color)
+			&& read_color(node.text_color)
+			&& read_color(node.cursor_color)
+			&& read(node.font_size)
+			&& read(node.gap)
+			&& read(node.padding)
+			&& read(node.flex.grow)
+			&& read(node.flex.shrink)
+			&& read(node.flex.basis)
+			&& read(node.flex.min_size)
+			&& read(node.flex.max_size)
+			&& read_string(node.id)
+			&& read_string(node.text)
+			&& read_string(node.placeholder_text)
+			&& read_string(node.path)
+			&& read_string(node.tag)
+			&& read(child_count);
+		if (!valid || child_count > remaining()) return false;
+		node.cached = cached != 0;
+
+		node.children.resize(child_count);
+		for (auto& child : node.children) {
+			if (!read_node(child)) return false;
+		}
+		return true;
+	}
+
+	std::size_t remaining() const { return static_cast<std::size_t>(m_end - m_data); }
+	bool at_end() const { return m_data == m_end; }
+private:
+	const char* m_data;
+	const char* m_end;
+};
+
+} // namespace
+
+// "SCREEN_SIZE_X", "SCREEN_SIZE_Y", "NN%" or a pixel count, left unset if unreadable
+SizeValue thd::parse_size(const char* size_attr) {
+	SizeValue size;
+	if (!size_attr) return size;
+
+	const std::string_view size_str(size_attr);
+	const char* begin = size_str.data();
+	const char* end = begin + size_str.size();
+
+	if (size_str == "SCREEN_SIZE_X") {
+		size.unit = SizeUnit::ScreenX;
+	}
+	else if (size_str == "SCREEN_SIZE_Y") {
+		size.unit = SizeUnit::ScreenY;
+	}
+	else if (!size_str.empty() && size_str.back() == '%') {
+		if (scan_number(begin, end - 1, size.value)) size.unit = SizeUnit::Percent;
+	}
+	else if (scan_number(begin, end, size.value)) {
+		size.unit = SizeUnit::Pixels;
+	}
+	return size;
+}
+
+// "r,g,b" or "r,g,b,a", any single character separates the channels
+sf::Color thd::parse_color(const char* color_str) {
+	if (!color_str) return sf::Color::White;
+
+	const char* it = color_str;
+	const char* end = it + std::strlen(it);
+	int channels[4] = { 255, 255, 255, 255 };
+
+	for (int i = 0; i < 4; ++i) {
+		const char* next = nullptr;
+		if (i > 0) {
+			it = skip_spaces(it, end);
+			if (it != end) {
+				next = scan_number(it + 1, end, channels[i]);
+			}
+		}
+		else {
+			next = scan_number(it, end, channels[i]);
+		}
+
+		if (!next) {
+			// Alpha is optional
+			if (i < 3) return sf::Color::White;
+			break;
+		}
+		it = next;
+	}
+
+	return sf::Color(
+		static_cast<uint8_t>(channels[0]),
+		static_cast<uint8_t>(channels[1]),
+		static_cast<uint8_t>(channels[2]),
+		static_cast<uint8_t>(channels[3])
+	);
+}
+
+bool thd::same_attributes(const LayoutNode& a, const LayoutNode& b, bool ignore_placement) {
+	if (!ignore_placement && (a.position != b.position || a.anchor_point != b.anchor_point)) {
+		return false;
+	}
+
+	return a.type == b.type
+		&& a.tag == b.tag
+		&& a.id == b.id
+		&& a.text == b.text
+		&& a.placeholder_text == b.placeholder_text
+		&& a.path == b.path
+		&& a.width == b.width
+		&& a.height == b.height
+		&& a.color == b.color
+		&& a.hover_color == b.hover_color
+		&& a.click_color == b.click_color
+		&& a.text_color == b.text_color
+		&& a.cursor_color == b.cursor_color
+		&& a.font_size == b.font_size
+		&& a.alignment == b.alignment
+		&& a.fit == b.fit
+		&& a.cached == b.cached
+		&& a.gap == b.gap
+		&& a.padding == b.padding
+		&& a.flex.grow == b.flex.grow
+		&& a.flex.shrink == b.flex.shrink
+		&& a.flex.basis == b.flex.basis
+		&& a.flex.min_size == b.flex.min_size
+		&& a.flex.max_size == b.flex.max_size;
+}
+
+bool thd::parse_layout_node(const tinyxml2::XMLElement* element, LayoutNode& node) {
+	if (!parse_layout_attributes(element, node)) return false;
+
+	if (node.type == ElementType::Container) {
+		for (const tinyxml2::XMLElement* child = element->FirstChildElement();
+			child != nullptr;
+			child = child->NextSiblingElement()) {
+
+			LayoutNode child_node;
+			if (parse_layout_node(child, child_node)) {
+				node.children.push_back(std::move(child_node));
+			}
+		}
+	}
+	return true;
+}
+
+bool thd::parse_layout_attributes(const tinyxml2::XMLElement* element, LayoutNode& node) {
+	const char* tag = element->Value();
+	if (!parse_element_type(tag, node.type)) {
+		if (!ElementRegistry::get().contains(tag)) return false;
+
+		node.type = ElementType::Custom;
+		node.tag = tag;
+	}
+
+	const AttributeValues attributes(element);
+
+	if (attributes[Attribute::X]) tinyxml2::XMLUtil::ToFloat(attributes[Attribute::X], &node.position.x);
+	if (attributes[Attribute::Y]) tinyxml2::XMLUtil::ToFloat(attributes[Attribute::Y], &node.position.y);
+	node.width = parse_size(attributes[Attribute::Width]);
+	node.height = parse_size(attributes[Attribute::Height]);
+	node.anchor_point = parse_anchor_point(attributes[Attribute::AnchorPoint]);
+	int font_size = 24;
+	if (attributes[Attribute::FontSize]) tinyxml2::XMLUtil::ToInt(attributes[Attribute::FontSize], &font_size);
+	node.font_size = static_cast<unsigned>(font_size);
+	node.color = parse_color(attributes[Attribute::Color]);
+	parse_float(attributes[Attribute::Grow], node.flex.grow);
+	parse_float(attributes[Attribute::Shrink], node.flex.shrink);
+	parse_float(attributes[Attribute::Basis], node.flex.basis);
+	parse_float(attributes[Attribute::MinSize], node.flex.min_size);
+	parse_float(attributes[Attribute::MaxSize], node.flex.max_size);
+
+	switch (node.type) {
+	case ElementType::Button:
+		node.text = parse_string(attributes[Attribute::Label], "Button");
+		node.id = node.text;
+		node.hover_color = parse_color(attributes[Attribute::HoverColor]);
+		node.click_color = parse_color(attributes[Attribute::ClickColor]);
+		break;
+	case ElementType::Container: {
+		node.id = "container";
+		node.alignment = parse_string(attributes[Attribute::Alignment], "") == "horizontal" ? AlignmentType::Horizontal : AlignmentType::Vertical;
+		node.fit = parse_fit(attributes[Attribute::Fit]);
+		parse_float(attributes[Attribute::Gap], node.gap);
+		parse_float(attributes[Attribute::Padding], node.padding);
+		bool cached = false;
+		if (attributes[Attribute::Cache]) tinyxml2::XMLUtil::ToBool(attributes[Attribute::Cache], &cached);
+		node.cached = cached;
+		break;
+	}
+	case ElementType::Image:
+		node.id = parse_string(attributes[Attribute::Id], "image");
+		node.path = parse_string(attributes[Attribute::Path], "");
+		if (node.path.empty()) return false;
+		break;
+	case ElementType::Label:
+		node.id = parse_string(attributes[Attribute::Id], "label");
+		node.text = parse_string(attributes[Attribute::Text], "Label");
+		break;
+	case ElementType::InputField:
+		node.id = parse_string(attributes[Attribute::Id], "inputField");
+		node.text = parse_string(attributes[Attribute::Text], "");
+		node.placeholder_text = parse_string(attributes[Attribute::PlaceholderText], "");
+		node.text_color = parse_color(attributes[Attribute::TextColor]);
+		node.cursor_color = parse_color(attributes[Attribute::CursorColor]);
+		break;
+	case ElementType::TextScroll:
+		node.id = parse_string(attributes[Attribute::Id], "textScroll");
+		node.text = parse_string(attributes[Attribute::Text], "");
+		node.path = parse_string(attributes[Attribute::Path], "");
+		node.text_color = parse_color(attributes[Attribute::TextColor]);
+		break;
+	case ElementType::Custom:
+		// Custom elements receive every common attribute and pick what they need
+		node.id = parse_string(attributes[Attribute::Id], node.tag.c_str());
+		node.text = parse_string(attributes[Attribute::Text], "");
+		node.placeholder_text = parse_string(attributes[Attribute::PlaceholderText], "");
+		node.path = parse_string(attributes[Attribute::Path], "");
+		node.hover_color = parse_color(attributes[Attribute::HoverColor]);
+		node.click_color = parse_color(attributes[Attribute::ClickColor]);
+		node.text_color = parse_color(attributes[Attribute::TextColor]);
+		node.cursor_color = parse_color(attributes[Attribute::CursorColor]);
+		break;
+	}
+
+	return true;
+}
+
+void thd::write_compiled_layout(const std::vector<LayoutNode>& nodes, std::vector<char>& output) {
+	LayoutWriter writer(output);
+
+	output.insert(output.end(), COMPILED_LAYOUT_MAGIC, COMPILED_LAYOUT_MAGIC + sizeof(COMPILED_LAYOUT_MAGIC));
+	writer.write(COMPILED_LAYOUT_VERSION);
+	writer.write(static_cast<unsigned>(nodes.size()));
+	for (const auto& node : nodes) {
+		writer.write_node(node);
+	}
+}
+
+bool thd::read_compiled_layout(const char* data, std::size_t size, std::vector<LayoutNode>& nodes) {
+	if (size < sizeof(COMPILED_LAYOUT_MAGIC) || std::memcmp(data, COMPILED_LAYOUT_MAGIC, sizeof(COMPILED_LAYOUT_MAGIC)) != 0) {
+		return false;
+	}
+
+	LayoutReader reader(data + sizeof(COMPILED_LAYOUT_MAGIC), size - sizeof(COMPILED_LAYOUT_MAGIC));
+	unsigned version = 0, node_count = 0;
+	if (!reader.read(version) || version != COMPILED_LAYOUT_VERSION || !reader.read(node_count) || node_count > reader.remaining()) {
+		return false;
+	}
+
+	nodes.resize(node_count);
+	for (auto& node : nodes) {
+		if (!reader.read_node(node)) return false;
+	}
+	return reader.at_end();
+}
@@ -0,0 +1,67 @@
+#ifndef LAYOUT_NODE_HPP
+#define LAYOUT_NODE_HPP
+
+#include "../GUI/container.hpp"
+#include "tinyxml2.h"
+#include <vector>
+
+namespace thd
+{
+
+enum class ElementType : unsigned char {
+	Button,
+	Container,
+	Image,
+	Label,
+	InputField,
+	TextScroll,
+	// A tag registered with the ElementRegistry
+	Custom
+};
+
+// Attributes of one page element with defaults applied, independent of the screen size
+struct LayoutNode {
+	ElementType type = ElementType::Container;
+	std::string id;
+	std::string text;
+	std::string placeholder_text;
+	std::string path;
+	// Tag name of custom elements
+	std::string tag;
+	sf::Vector2f position;
+	SizeValue width;
+	SizeValue height;
+	sf::Color color = sf::Color::White;
+	sf::Color hover_color = sf::Color::White;
+	sf::Color click_color = sf::Color::White;
+	sf::Color text_color = sf::Color::White;
+	sf::Color cursor_color = sf::Color::White;
+	unsigned font_size = 24;
+	AnchorPoint anchor_point = AnchorPoint::TopLeft;
+	AlignmentType alignment = AlignmentType::Vertical;
+	FitType fit = FitType::Default;
+	bool cached = false;
+	float gap = 0.0f;
+	float padding = 0.0f;
+	FlexItem flex;
+	std::vector<LayoutNode> children;
+};
+
+// Attribute value parsers, they never allocate
+SizeValue parse_size(const char* size_attr);
+sf::Color parse_color(const char* color_str);
+
+// Compares everything but the children, optionally ignoring position and anchor point
+bool same_attributes(const LayoutNode& a, const LayoutNode& b, bool ignore_placement = false);
+
+// Parses the element and its subtree, returns false if the element does not describe a component
+bool parse_layout_node(const tinyxml2::XMLElement* element, LayoutNode& node);
+// Parses only the element's own attributes, leaving node.children empty
+bool parse_layout_attributes(const tinyxml2::XMLElement* element, LayoutNode& node);
+
+// Binary layout blob: "THDL", format version, then the nodes in pre-order (native little-endian)
+void write_compiled_layout(const std::vector<LayoutNode>& nodes, std::vector<char>& output);
+bool read_compiled_layout(const char* data, std::size_t size, std::vector<LayoutNode>& nodes);
+
+} // namespace thd
+#endif // LAYOUT_NODE_HPP
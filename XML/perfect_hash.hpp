@@ -0,0 +1,57 @@
+#ifndef PERFECT_HASH_HPP
+#define PERFECT_HASH_HPP
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace thd
+{
+
+constexpr std::uint32_t fnv1a(std::string_view key, std::uint32_t seed) {
+	std::uint32_t hash = 2166136261u ^ seed;
+	for (const char c : key) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+// Collision free lookup over a fixed key set, the seed is searched for at compile time
+// so a lookup costs one hash and one string comparison
+template <std::size_t N, std::size_t TableSize>
+class PerfectHash {
+	static_assert((TableSize & (TableSize - 1)) == 0, "Table size must be a power of two");
+	static_assert(N < TableSize && N < 255, "Too many keys for the table");
+public:
+	constexpr explicit PerfectHash(const std::array<std::string_view, N>& keys) : m_keys(keys) {
+		while (!try_seed(m_seed)) {
+			m_seed++;
+		}
+	}
+
+	// Position of the key in the set, -1 if it is not part of it
+	constexpr int find(std::string_view key) const {
+		const unsigned char slot = m_slots[fnv1a(key, m_seed) & (TableSize - 1)];
+		return slot != 0 && m_keys[slot - 1] == key ? slot - 1 : -1;
+	}
+private:
+	constexpr bool try_seed(std::uint32_t seed) {
+		for (auto& slot : m_slots) {
+			slot = 0;
+		}
+		for (std::size_t i = 0; i < N; ++i) {
+			auto& slot = m_slots[fnv1a(m_keys[i], seed) & (TableSize - 1)];
+			if (slot != 0) return false;
+			slot = static_cast<unsigned char>(i + 1);
+		}
+		return true;
+	}
+
+	std::array<std::string_view, N> m_keys;
+	std::array<unsigned char, TableSize> m_slots{};
+	std::uint32_t m_seed = 0;
+};
+
+} // namespace thd
+#endif // PERFECT_HASH_HPP
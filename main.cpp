@@ -1,28 +1,17 @@
 #include "XML/document.hpp"
+#include "GUI/event_router.hpp"
+#include "GUI/dirty_rect_renderer.hpp"
+#include "GUI/asset_loader.hpp"
+#include "GUI/profiler.hpp"
+#include "GUI/components/profiler_overlay.hpp"
+#include "GUI/font_registry.hpp"
 #include <iostream>
+#include <string>
 
 constexpr float SCREEN_WIDTH = 1080.0f;
 constexpr float SCREEN_HEIGHT = 720.0f;
 
-std::shared_ptr<thd::Component> find_component_recursive(const std::shared_ptr<thd::Container>& container, const std::string& id) {
-	auto component = container->get_component(id);
-	if (component) {
-		return component;
-	}
-
-	for (const auto& sub_component : container->get_components()) {
-		auto sub_container = std::dynamic_pointer_cast<thd::Container>(sub_component);
-		if (sub_container) {
-			component = find_component_recursive(sub_container, id);
-			if (component) {
-				return component;
-			}
-		}
-	}
-	return nullptr;
-}
-
-int main() {
+int main(int argc, char** argv) {
 	auto window = std::make_unique<sf::RenderWindow>(
 		sf::VideoMode(static_cast<unsigned>(SCREEN_WIDTH), static_cast<unsigned>(SCREEN_HEIGHT)),
 		"Thorned",
@@ -32,7 +21,18 @@ int main() {
 	window->setFramerateLimit(60);
 
 	thd::Document doc("Assets/example/page.xml", SCREEN_WIDTH, SCREEN_HEIGHT, "Assets/hHachimaki.ttf");
-	doc.load("Assets/example/page.xml");
+	// --watch applies edits to the page while the app runs, the loop then polls the file
+	// instead of sleeping until the next event
+	bool watch_page = false;
+	for (int i = 1; i < argc; ++i) {
+		if (std::string(argv[i]) == "--watch") watch_page = true;
+	}
+	if (watch_page) {
+		doc.watch("Assets/example/page.xml");
+	}
+	else {
+		doc.load("Assets/example/page.xml");
+	}
 
 	auto main_container = doc.get_main_container();
 	if (!main_container) {
@@ -40,34 +40,106 @@ int main() {
 		return -1;
 	}
 
-	auto name_input = find_component_recursive(main_container, "name");
-	auto output = find_component_recursive(main_container, "output");
+	auto name_input = doc.find_component("name");
+	auto output = doc.find_component("output");
+
+	thd::Profiler& profiler = thd::Profiler::get();
+
+	// F3 shows the frame stats on top of the page, the profiler only runs while they are shown
+	const thd::FontHandle overlay_font = thd::FontRegistry::get().load("Assets/hHachimaki.ttf");
+	std::unique_ptr<thd::ProfilerOverlay> overlay;
+	if (overlay_font) {
+		overlay = std::make_unique<thd::ProfilerOverlay>("profiler", *overlay_font, 14, sf::Vector2f(8.0f, 8.0f));
+	}
+	bool show_overlay = false;
+
+	thd::EventRouter event_router(main_container);
+	thd::DirtyRectRenderer renderer(sf::Color(30, 30, 30));
+
+	const auto handle_event = [&](const sf::Event& event) {
+		if (event.type == sf::Event::Closed) {
+			window->close();
+		}
+		if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3 && overlay) {
+			show_overlay = !show_overlay;
+			profiler.set_enabled(show_overlay);
+			main_container->invalidate_render(thd::Component::FULL_DAMAGE);
+		}
+		// Keep one unit per pixel instead of stretching the page, then lay it out for the new size
+		if (event.type == sf::Event::Resized) {
+			const sf::Vector2f size(static_cast<float>(event.size.width), static_cast<float>(event.size.height));
+			window->setView(sf::View(sf::FloatRect(0.0f, 0.0f, size.x, size.y)));
+			doc.resize(size);
+		}
+		// The window contents are lost when it is resized or uncovered
+		if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus) {
+			main_container->invalidate_render(thd::Component::FULL_DAMAGE);
+		}
+
+		event_router.route(event, *window);
+	};
+
+	thd::AssetLoader& assets = thd::AssetLoader::get();
 
 	sf::Clock clock;
 	while (window->isOpen()) {
-		sf::Time dt = clock.restart();
 		sf::Event event;
-		while (window->pollEvent(event)) {
-			if (event.type == sf::Event::Closed) {
-				window->close();
-			}
 
-			for (const auto& component : main_container->get_components()) {
-				component->handle_event(event, *window);
+		// Nothing changed, nothing is animating and no asset is loading, sleep until the next event
+		// a watched page has to keep polling its file instead
+		if (!main_container->needs_redraw() && !main_container->needs_layout() && !main_container->is_animating()
+			&& !assets.has_pending() && !doc.is_watching() && !show_overlay) {
+			if (window->waitEvent(event)) {
+				handle_event(event);
 			}
 		}
 
+		sf::Time dt = clock.restart();
+		profiler.begin_frame();
+		while (window->pollEvent(event)) {
+			handle_event(event);
+		}
+
+		assets.poll();
+
+		if (doc.poll_changes()) {
+			name_input = doc.find_component("name");
+			output = doc.find_component("output");
+		}
+
 		if (output && name_input) {
 			output->set_label_text(name_input->get_label()->getString().toAnsiString());
 		}
 
-		for (const auto& component : main_container->get_components()) {
-			component->update(dt.asSeconds(), *window);
+		main_container->flush_layout();
+
+		{
+			thd::ProfileScope scope(thd::ProfileSection::Update);
+			for (const auto& component : main_container->get_components()) {
+				component->update(dt.asSeconds(), *window);
+			}
 		}
 
-		window->clear(sf::Color(30, 30, 30));
-		main_container->render(*window);
-		window->display();
+		if (show_overlay) {
+			overlay->update(dt.asSeconds(), *window);
+		}
+
+		if (main_container->needs_redraw() || (show_overlay && overlay->needs_redraw())) {
+			renderer.render(*main_container, *window);
+			if (show_overlay) {
+				overlay->render(*window);
+				overlay->clear_redraw();
+			}
+			// The frame limiter's wait is not part of the frame
+			profiler.end_frame();
+			window->display();
+		}
+		else {
+			// Frames that draw nothing would only dilute the averages
+			profiler.discard_frame();
+			// display() is what applies the frame limit, keep animations from spinning
+			sf::sleep(sf::milliseconds(16));
+		}
 	}
 
 	return 0;
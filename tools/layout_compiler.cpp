@@ -0,0 +1,45 @@
+#include "../XML/layout_node.hpp"
+#include <fstream>
+#include <iostream>
+
+// Compiles a page XML into the binary layout read by Document::load_compiled
+int main(int argc, char** argv) {
+	if (argc != 3) {
+		std::cerr << "Usage: " << argv[0] << " <page.xml> <page.thdl>" << std::endl;
+		return 1;
+	}
+
+	tinyxml2::XMLDocument document;
+	if (document.LoadFile(argv[1]) != tinyxml2::XML_SUCCESS) {
+		std::cerr << "Error loading file: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	const tinyxml2::XMLElement* root = document.RootElement();
+	if (!root) {
+		std::cerr << "Error: Root element not found in " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::vector<thd::LayoutNode> nodes;
+	for (const tinyxml2::XMLElement* child = root->FirstChildElement();
+		child != nullptr;
+		child = child->NextSiblingElement()) {
+
+		thd::LayoutNode node;
+		if (thd::parse_layout_node(child, node)) {
+			nodes.push_back(std::move(node));
+		}
+	}
+
+	std::vector<char> blob;
+	thd::write_compiled_layout(nodes, blob);
+
+	std::ofstream output(argv[2], std::ios::binary);
+	if (!output.write(blob.data(), static_cast<std::streamsize>(blob.size()))) {
+		std::cerr << "Error writing file: " << argv[2] << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
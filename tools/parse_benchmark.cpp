@@ -0,0 +1,99 @@
+#include "../XML/layout_node.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Times the attribute parsers against the istringstream and std::stof versions they replaced
+namespace
+{
+
+thd::SizeValue legacy_parse_size(const char* size_attr) {
+	thd::SizeValue size;
+	if (!size_attr) return size;
+
+	const std::string size_str(size_attr);
+	if (size_str == "SCREEN_SIZE_X") {
+		size.unit = thd::SizeUnit::ScreenX;
+	}
+	else if (size_str == "SCREEN_SIZE_Y") {
+		size.unit = thd::SizeUnit::ScreenY;
+	}
+	else if (size_str.back() == '%') {
+		size.unit = thd::SizeUnit::Percent;
+		size.value = std::stof(size_str.substr(0, size_str.size() - 1));
+	}
+	else {
+		size.unit = thd::SizeUnit::Pixels;
+		size.value = std::stof(size_str);
+	}
+	return size;
+}
+
+sf::Color legacy_parse_color(const char* color_str) {
+	if (!color_str) return sf::Color::White;
+
+	int r = 255, g = 255, b = 255, a = 255;
+	std::istringstream color_stream(color_str);
+	char separator;
+
+	if (!(color_stream >> r >> separator >> g >> separator >> b)) {
+		return sf::Color::White;
+	}
+
+	if (color_stream >> separator >> a) {}
+
+	return sf::Color(
+		static_cast<uint8_t>(r),
+		static_cast<uint8_t>(g),
+		static_cast<uint8_t>(b),
+		static_cast<uint8_t>(a)
+	);
+}
+
+// Keeps the optimizer from dropping the parsed values
+volatile unsigned g_sink = 0;
+
+template <typename Parse>
+double nanoseconds_per_call(Parse parse, const char* const* inputs, std::size_t input_count, std::size_t iterations) {
+	double best = 1e30;
+	for (int run = 0; run < 5; ++run) {
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i) {
+			parse(inputs[i % input_count]);
+		}
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count() / iterations);
+	}
+	return best;
+}
+
+void report(const char* name, double legacy, double current) {
+	std::cout << std::left << std::setw(10) << name << std::right
+		<< std::setw(14) << std::fixed << std::setprecision(1) << legacy
+		<< std::setw(14) << current
+		<< std::setw(10) << std::setprecision(1) << legacy / current << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	const std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+	const char* const colors[] = { "255,255,255", "30, 30, 30", "12,200,64,128", "0,0,0,0" };
+	const char* const sizes[] = { "100", "50%", "SCREEN_SIZE_X", "320.5", "SCREEN_SIZE_Y", "12.5%" };
+
+	std::cout << std::left << std::setw(10) << "attribute" << std::right
+		<< std::setw(14) << "legacy ns" << std::setw(14) << "current ns" << std::setw(11) << "speedup" << std::endl;
+
+	report("color",
+		nanoseconds_per_call([](const char* text) { g_sink = g_sink + legacy_parse_color(text).r; }, colors, 4, iterations),
+		nanoseconds_per_call([](const char* text) { g_sink = g_sink + thd::parse_color(text).r; }, colors, 4, iterations));
+	report("size",
+		nanoseconds_per_call([](const char* text) { g_sink = g_sink + static_cast<unsigned>(legacy_parse_size(text).value); }, sizes, 6, iterations),
+		nanoseconds_per_call([](const char* text) { g_sink = g_sink + static_cast<unsigned>(thd::parse_size(text).value); }, sizes, 6, iterations));
+
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include "../GUI/components/text_scroll.hpp"
+#include "../GUI/font_registry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+// Times TextScroll word wrapping on growing texts, the cost per character stays flat when wrapping is linear
+int main(int argc, char** argv) {
+	const std::string font_path = argc > 1 ? argv[1] : "Assets/hHachimaki.ttf";
+	const thd::FontHandle font = thd::FontRegistry::get().load(font_path);
+	if (!font) {
+		std::cerr << "Usage: " << argv[0] << " [font.ttf]" << std::endl;
+		return 1;
+	}
+
+	// Log-like text, words of 1-12 letters and lines of up to 400 characters, so most lines wrap
+	std::mt19937 random(42);
+	std::uniform_int_distribution<int> word_length(1, 12);
+	std::uniform_int_distribution<int> line_length(20, 400);
+	std::uniform_int_distribution<int> letter('a', 'z');
+
+	std::string text;
+	const std::size_t max_size = 8u << 20;
+	text.reserve(max_size);
+	while (text.size() < max_size) {
+		const std::size_t line_end = text.size() + line_length(random);
+		while (text.size() < line_end) {
+			for (int i = word_length(random); i > 0; --i) {
+				text += static_cast<char>(letter(random));
+			}
+			text += ' ';
+		}
+		text += '\n';
+	}
+
+	thd::TextScroll scroll("benchmark", "", *font, sf::Vector2f(0.f, 0.f), sf::Vector2f(600.f, 400.f),
+		sf::Color::Black, sf::Color::White, 16, 1080.f, 720.f);
+
+	std::cout << std::setw(12) << "bytes" << std::setw(12) << "ms" << std::setw(14) << "ns/byte" << std::endl;
+	for (std::size_t size = 64u << 10; size <= max_size; size *= 2) {
+		const std::string sample = text.substr(0, size);
+
+		// Best of three, the first run also fills the glyph metrics
+		double best = 1e30;
+		for (int run = 0; run < 3; ++run) {
+			const auto start = std::chrono::steady_clock::now();
+			scroll.set_text(sample);
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			best = std::min(best, elapsed.count());
+		}
+
+		std::cout << std::setw(12) << size << std::setw(12) << std::fixed << std::setprecision(2) << best
+			<< std::setw(14) << std::setprecision(2) << best * 1e6 / size << std::endl;
+	}
+
+	return 0;
+}